@@ -0,0 +1,41 @@
+#ifndef FLUTTER_WEBRTC_BENCHMARKS_BENCHMARK_UTIL_H_
+#define FLUTTER_WEBRTC_BENCHMARKS_BENCHMARK_UTIL_H_
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace flutter_webrtc_benchmarks {
+
+// Runs |body| once to warm up, then repeatedly for at least |min_time|, and
+// returns the mean wall time of one run in microseconds.
+template <typename Body>
+double MeasureMicroseconds(
+    Body&& body,
+    std::chrono::milliseconds min_time = std::chrono::milliseconds(300)) {
+  body();
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::duration::zero();
+  int64_t runs = 0;
+  do {
+    body();
+    runs++;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < min_time);
+  return std::chrono::duration<double, std::micro>(elapsed).count() / runs;
+}
+
+// Deterministic noise, so that runs compare like with like.
+inline std::vector<uint8_t> NoiseBytes(size_t size, uint32_t seed = 1) {
+  std::vector<uint8_t> bytes(size);
+  uint32_t state = seed;
+  for (uint8_t& byte : bytes) {
+    state = state * 1664525u + 1013904223u;
+    byte = static_cast<uint8_t>(state >> 24);
+  }
+  return bytes;
+}
+
+}  // namespace flutter_webrtc_benchmarks
+
+#endif  // FLUTTER_WEBRTC_BENCHMARKS_BENCHMARK_UTIL_H_
@@ -0,0 +1,198 @@
+// Counts the heap allocations, and times, of delivering each kind of data
+// channel event: FlutterRTCDataChannelObserver builds it from its
+// EventTemplate and posts it through its EventChannelProxy, which sends it
+// to a listening Dart side encoded by the standard codec. The same events
+// built from scratch with freshly allocated keys, as the observer used to,
+// go through an identical channel for comparison. Allocations are counted by
+// replacing the global operator new.
+//
+// The peer connection and renderer observers only exist inside the whole
+// plugin, so their events are not covered here.
+
+#include "benchmark_util.h"
+#include "flutter_data_channel.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+size_t g_allocations = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocations++;
+  if (void* p = malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+using namespace flutter_webrtc_benchmarks;
+using namespace flutter_webrtc_plugin;
+
+namespace flutter_webrtc_plugin {
+
+// flutter_data_channel.cc's FlutterDataChannel needs this from
+// flutter_webrtc_base.cc, which would pull in the rest of the plugin. Only
+// the observer is used here, which never calls it.
+std::string FlutterWebRTCBase::GenerateUUID() {
+  return std::string();
+}
+
+}  // namespace flutter_webrtc_plugin
+
+namespace {
+
+const std::string kMessage(64, 'x');
+const int kDataChannelId = 1;
+
+// Stands in for the engine: records the stream handlers, starts listening
+// like the Dart side does, and counts what is sent.
+class FakeMessenger : public BinaryMessenger {
+ public:
+  void Send(const std::string& channel,
+            const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply) const override {
+    messages_sent_++;
+  }
+
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override {
+    handlers_[channel] = std::move(handler);
+  }
+
+  void Listen(const std::string& channel) {
+    std::unique_ptr<std::vector<uint8_t>> message =
+        flutter::StandardMethodCodec::GetInstance().EncodeMethodCall(
+            MethodCall("listen", nullptr));
+    handlers_[channel](message->data(), message->size(),
+                       [](const uint8_t* reply, size_t reply_size) {});
+  }
+
+  size_t messages_sent() const { return messages_sent_; }
+
+ private:
+  std::map<std::string, flutter::BinaryMessageHandler> handlers_;
+  mutable size_t messages_sent_ = 0;
+};
+
+// Runs every task at once, as if the platform thread were idle.
+class InlineTaskRunner : public TaskRunner {
+ public:
+  void EnqueueTask(TaskClosure task, TaskPriority priority) override {
+    task();
+  }
+};
+
+class FakeDataChannel : public RTCDataChannel {
+ public:
+  void Send(const uint8_t* data, uint32_t size, bool binary) override {}
+  void Close() override {}
+  void RegisterObserver(RTCDataChannelObserver* observer) override {}
+  void UnregisterObserver() override {}
+  const string label() const override { return string("benchmark"); }
+  int id() const override { return kDataChannelId; }
+  uint64_t buffered_amount() const override { return 0; }
+  RTCDataChannelState state() override { return RTCDataChannelOpen; }
+};
+
+// The observer's events as it built them before EventTemplate.
+namespace legacy {
+
+EncodableValue Message(const char* buffer, int length, bool binary) {
+  EncodableMap params;
+  params[EncodableValue("event")] = EncodableValue("dataChannelReceiveMessage");
+  params[EncodableValue("id")] = EncodableValue(kDataChannelId);
+  params[EncodableValue("type")] = EncodableValue(binary ? "binary" : "text");
+  std::string str(buffer, length);
+  if (binary) {
+    params[EncodableValue("data")] =
+        EncodableValue(std::vector<uint8_t>(str.begin(), str.end()));
+  } else {
+    params[EncodableValue("data")] = EncodableValue(str);
+  }
+  return EncodableValue(params);
+}
+
+EncodableValue StateChanged() {
+  EncodableMap params;
+  params[EncodableValue("event")] = EncodableValue("dataChannelStateChanged");
+  params[EncodableValue("id")] = EncodableValue(kDataChannelId);
+  params[EncodableValue("state")] = EncodableValue("open");
+  return EncodableValue(params);
+}
+
+}  // namespace legacy
+
+struct EventKind {
+  const char* name;
+  std::function<void()> legacy;
+  std::function<void()> current;
+};
+
+// Allocations made while delivering one event.
+size_t CountAllocations(const std::function<void()>& deliver) {
+  size_t before = g_allocations;
+  deliver();
+  return g_allocations - before;
+}
+
+}  // namespace
+
+int main() {
+  FakeMessenger messenger;
+  InlineTaskRunner task_runner;
+  scoped_refptr<RTCDataChannel> data_channel =
+      scoped_refptr<RTCDataChannel>(new RefCountedObject<FakeDataChannel>());
+  FlutterRTCDataChannelObserver observer(data_channel, &messenger,
+                                         &task_runner, "current");
+  std::unique_ptr<EventChannelProxy> legacy_channel =
+      EventChannelProxy::Create(&messenger, &task_runner, "legacy",
+                                TaskPriority::kBulkData,
+                                EventDropPolicy::kDropNewest);
+  messenger.Listen("current");
+  messenger.Listen("legacy");
+
+  const char* buffer = kMessage.data();
+  int length = static_cast<int>(kMessage.size());
+  const EventKind kinds[] = {
+      {"dataChannelReceiveMessage text",
+       [&] { legacy_channel->Success(legacy::Message(buffer, length, false)); },
+       [&] { observer.OnMessage(buffer, length, false); }},
+      {"dataChannelReceiveMessage binary",
+       [&] { legacy_channel->Success(legacy::Message(buffer, length, true)); },
+       [&] { observer.OnMessage(buffer, length, true); }},
+      {"dataChannelStateChanged",
+       [&] { legacy_channel->Success(legacy::StateChanged()); },
+       [&] { observer.OnStateChange(RTCDataChannelOpen); }},
+  };
+
+  printf("%-33s %17s %21s\n", "event", "allocations", "time");
+  printf("%-33s %8s %8s %10s %10s\n", "", "legacy", "current", "legacy",
+         "current");
+  for (const EventKind& kind : kinds) {
+    size_t legacy_allocations = CountAllocations(kind.legacy);
+    size_t current_allocations = CountAllocations(kind.current);
+    double legacy_us = MeasureMicroseconds(kind.legacy);
+    double current_us = MeasureMicroseconds(kind.current);
+    printf("%-33s %8zu %8zu %7.0f ns %7.0f ns\n", kind.name,
+           legacy_allocations, current_allocations, legacy_us * 1000,
+           current_us * 1000);
+  }
+  printf("\n%zu messages sent\n", messenger.messages_sent());
+  return 0;
+}
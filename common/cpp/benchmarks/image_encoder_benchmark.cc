@@ -0,0 +1,103 @@
+// Times captureFrame's image encoders, and the size of what they produce,
+// against the uncompressed PNG that svpng used to write.
+
+#include "benchmark_util.h"
+#include "flutter_image_encoder.h"
+
+#include <cstdio>
+#include <vector>
+
+// Collect svpng's output in memory, so that both sides skip the disk.
+#define SVPNG_OUTPUT std::vector<uint8_t>* out
+#define SVPNG_PUT(u) out->push_back(static_cast<uint8_t>(u))
+#include "svpng.hpp"
+
+using namespace flutter_webrtc_benchmarks;
+using namespace flutter_webrtc_plugin;
+
+namespace {
+
+struct FrameSize {
+  const char* name;
+  int width;
+  int height;
+};
+
+const FrameSize kFrameSizes[] = {
+    {"720p", 1280, 720},
+    {"1080p", 1920, 1080},
+    {"2160p", 3840, 2160},
+};
+
+struct Encoder {
+  const char* name;
+  ImageFormat format;
+  int quality;
+};
+
+const Encoder kEncoders[] = {
+    {"png", ImageFormat::kPNG, 0},
+    {"qoi", ImageFormat::kQOI, 0},
+    {"jpeg 90", ImageFormat::kJPEG, 90},
+    {"jpeg 75", ImageFormat::kJPEG, 75},
+};
+
+// Smooth gradients with a little sensor-like noise, which compresses roughly
+// like a camera frame. Pure noise would not compress at all.
+std::vector<uint8_t> TestImage(int width, int height) {
+  std::vector<uint8_t> noise =
+      NoiseBytes(static_cast<size_t>(width) * height * 3);
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      size_t i = static_cast<size_t>(y) * width + x;
+      uint8_t* pixel = &rgba[i * 4];
+      pixel[0] = static_cast<uint8_t>(x * 200 / width + (noise[i * 3] & 7));
+      pixel[1] =
+          static_cast<uint8_t>(y * 200 / height + (noise[i * 3 + 1] & 7));
+      pixel[2] = static_cast<uint8_t>(((x / 64 + y / 64) & 1) * 96 +
+                                      (noise[i * 3 + 2] & 7));
+      pixel[3] = 255;
+    }
+  }
+  return rgba;
+}
+
+void PrintResult(const char* size,
+                 const char* encoder,
+                 double microseconds,
+                 size_t bytes,
+                 size_t raw_bytes) {
+  printf("%-6s %-8s %9.1f ms %9.2f MB %6.1f%%\n", size, encoder,
+         microseconds / 1000, bytes / 1e6, 100.0 * bytes / raw_bytes);
+}
+
+}  // namespace
+
+int main() {
+  printf("%-6s %-8s %12s %12s %7s\n", "size", "encoder", "encode", "output",
+         "of raw");
+
+  for (const FrameSize& size : kFrameSizes) {
+    std::vector<uint8_t> rgba = TestImage(size.width, size.height);
+    size_t raw_bytes = rgba.size();
+
+    std::vector<uint8_t> image;
+    double microseconds = MeasureMicroseconds([&] {
+      image.clear();
+      svpng(&image, size.width, size.height, rgba.data(), 1);
+    });
+    PrintResult(size.name, "svpng", microseconds, image.size(), raw_bytes);
+
+    for (const Encoder& encoder : kEncoders) {
+      microseconds = MeasureMicroseconds([&] {
+        image = EncodeImage(rgba.data(), size.width, size.height,
+                            size.width * 4, encoder.format, encoder.quality);
+      });
+      PrintResult(size.name, encoder.name, microseconds, image.size(),
+                  raw_bytes);
+    }
+    printf("\n");
+  }
+  return 0;
+}
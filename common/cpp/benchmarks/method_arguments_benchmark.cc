@@ -0,0 +1,388 @@
+// Times argument decoding for the heaviest method calls, with the find*
+// helpers and interned keys, against the helpers they replaced: those built
+// an EncodableValue key per lookup, returned copies, and findLongInt walked
+// the whole map.
+
+#include "benchmark_util.h"
+#include "flutter_common.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace flutter_webrtc_benchmarks;
+using namespace flutter_webrtc_plugin;
+
+namespace {
+
+// What the handlers take out of the arguments before they reach libwebrtc.
+struct EncodingArgs {
+  bool active = true;
+  std::string rid;
+  int ssrc = 0;
+  int min_bitrate = 0;
+  int max_bitrate = 0;
+  int max_framerate = 0;
+  int num_temporal_layers = 0;
+  double scale_resolution_down_by = 1.0;
+  std::string scalability_mode;
+  std::string priority;
+  std::string network_priority;
+};
+
+struct TransceiverArgs {
+  std::string peer_connection_id;
+  std::string media_type;
+  std::string track_id;
+  std::string direction;
+  std::vector<std::string> stream_ids;
+  std::vector<EncodingArgs> encodings;
+};
+
+struct SenderParametersArgs {
+  std::string peer_connection_id;
+  std::string rtp_sender_id;
+  std::vector<EncodingArgs> encodings;
+  std::string degradation_preference;
+};
+
+struct RendererArgs {
+  std::string stream_id;
+  int64_t texture_id = 0;
+  std::string owner_tag;
+  std::string track_id;
+};
+
+// Three simulcast layers, as Dart sends them.
+EncodableList SimulcastEncodings() {
+  EncodableList encodings;
+  const char* rids[] = {"f", "h", "q"};
+  for (int i = 0; i < 3; i++) {
+    EncodableMap encoding;
+    encoding[EncodableValue("active")] = EncodableValue(true);
+    encoding[EncodableValue("rid")] = EncodableValue(rids[i]);
+    encoding[EncodableValue("maxBitrate")] = EncodableValue(2500000 >> i);
+    encoding[EncodableValue("maxFramerate")] = EncodableValue(30);
+    encoding[EncodableValue("numTemporalLayers")] = EncodableValue(3);
+    encoding[EncodableValue("scaleResolutionDownBy")] =
+        EncodableValue(static_cast<double>(1 << i));
+    encoding[EncodableValue("scalabilityMode")] = EncodableValue("L1T3");
+    encoding[EncodableValue("priority")] = EncodableValue("high");
+    encoding[EncodableValue("networkPriority")] = EncodableValue("medium");
+    encodings.push_back(EncodableValue(encoding));
+  }
+  return encodings;
+}
+
+EncodableMap AddTransceiverCall() {
+  EncodableMap init;
+  init[EncodableValue("direction")] = EncodableValue("sendonly");
+  init[EncodableValue("streamIds")] =
+      EncodableValue(EncodableList{EncodableValue("stream-0")});
+  init[EncodableValue("sendEncodings")] = EncodableValue(SimulcastEncodings());
+
+  EncodableMap params;
+  params[EncodableValue("peerConnectionId")] =
+      EncodableValue("a0e3a7a6-3f4c-4f7e-9d76-6f0b3c2d1e5a");
+  params[EncodableValue("mediaType")] = EncodableValue("video");
+  params[EncodableValue("trackId")] =
+      EncodableValue("8f1d2c3b-4a5e-46f7-8b9c-0d1e2f3a4b5c");
+  params[EncodableValue("transceiverInit")] = EncodableValue(init);
+  return params;
+}
+
+EncodableMap RtpSenderSetParametersCall() {
+  EncodableMap parameters;
+  parameters[EncodableValue("transactionId")] = EncodableValue("1");
+  parameters[EncodableValue("encodings")] =
+      EncodableValue(SimulcastEncodings());
+  parameters[EncodableValue("degradationPreference")] =
+      EncodableValue("balanced");
+
+  EncodableMap params;
+  params[EncodableValue("peerConnectionId")] =
+      EncodableValue("a0e3a7a6-3f4c-4f7e-9d76-6f0b3c2d1e5a");
+  params[EncodableValue("rtpSenderId")] =
+      EncodableValue("5b4a3c2d-1e0f-4a9b-8c7d-6e5f4a3b2c1d");
+  params[EncodableValue("parameters")] = EncodableValue(parameters);
+  return params;
+}
+
+EncodableMap VideoRendererSetSrcObjectCall() {
+  EncodableMap params;
+  params[EncodableValue("streamId")] = EncodableValue("stream-0");
+  params[EncodableValue("textureId")] = EncodableValue(int64_t{42});
+  params[EncodableValue("ownerTag")] = EncodableValue("local");
+  params[EncodableValue("trackId")] =
+      EncodableValue("8f1d2c3b-4a5e-46f7-8b9c-0d1e2f3a4b5c");
+  return params;
+}
+
+// The helpers as they were, copied from the tree before interned keys.
+namespace legacy {
+
+template <typename T>
+inline bool TypeIs(const EncodableValue val) {
+  return std::holds_alternative<T>(val);
+}
+
+template <typename T>
+inline const T GetValue(EncodableValue val) {
+  return std::get<T>(val);
+}
+
+inline EncodableValue findEncodableValue(const EncodableMap& map,
+                                         const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end())
+    return it->second;
+  return EncodableValue();
+}
+
+inline EncodableMap findMap(const EncodableMap& map, const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end() && TypeIs<EncodableMap>(it->second))
+    return GetValue<EncodableMap>(it->second);
+  return EncodableMap();
+}
+
+inline EncodableList findList(const EncodableMap& map, const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end() && TypeIs<EncodableList>(it->second))
+    return GetValue<EncodableList>(it->second);
+  return EncodableList();
+}
+
+inline std::string findString(const EncodableMap& map, const std::string& key) {
+  auto it = map.find(EncodableValue(key));
+  if (it != map.end() && TypeIs<std::string>(it->second))
+    return GetValue<std::string>(it->second);
+  return std::string();
+}
+
+inline int64_t findLongInt(const EncodableMap& map, const std::string& key) {
+  for (auto it : map) {
+    if (key == GetValue<std::string>(it.first)) {
+      if (TypeIs<int64_t>(it.second)) {
+        return GetValue<int64_t>(it.second);
+      } else if (TypeIs<int32_t>(it.second)) {
+        return GetValue<int32_t>(it.second);
+      }
+    }
+  }
+
+  return -1;
+}
+
+EncodingArgs DecodeEncoding(const EncodableMap& params) {
+  EncodingArgs args;
+  EncodableValue value = findEncodableValue(params, "active");
+  if (!value.IsNull())
+    args.active = GetValue<bool>(value);
+  value = findEncodableValue(params, "rid");
+  if (!value.IsNull())
+    args.rid = GetValue<std::string>(value);
+  value = findEncodableValue(params, "ssrc");
+  if (!value.IsNull())
+    args.ssrc = GetValue<int>(value);
+  value = findEncodableValue(params, "minBitrate");
+  if (!value.IsNull())
+    args.min_bitrate = GetValue<int>(value);
+  value = findEncodableValue(params, "maxBitrate");
+  if (!value.IsNull())
+    args.max_bitrate = GetValue<int>(value);
+  value = findEncodableValue(params, "maxFramerate");
+  if (!value.IsNull())
+    args.max_framerate = GetValue<int>(value);
+  value = findEncodableValue(params, "numTemporalLayers");
+  if (!value.IsNull())
+    args.num_temporal_layers = GetValue<int>(value);
+  value = findEncodableValue(params, "scaleResolutionDownBy");
+  if (!value.IsNull())
+    args.scale_resolution_down_by = GetValue<double>(value);
+  value = findEncodableValue(params, "scalabilityMode");
+  if (!value.IsNull())
+    args.scalability_mode = GetValue<std::string>(value);
+  value = findEncodableValue(params, "priority");
+  if (!value.IsNull())
+    args.priority = GetValue<std::string>(value);
+  value = findEncodableValue(params, "networkPriority");
+  if (!value.IsNull())
+    args.network_priority = GetValue<std::string>(value);
+  return args;
+}
+
+TransceiverArgs DecodeAddTransceiver(const EncodableValue& arguments) {
+  const EncodableMap params = GetValue<EncodableMap>(arguments);
+  TransceiverArgs args;
+  args.peer_connection_id = findString(params, "peerConnectionId");
+  const EncodableMap init = findMap(params, "transceiverInit");
+  args.media_type = findString(params, "mediaType");
+  args.track_id = findString(params, "trackId");
+
+  EncodableList stream_ids = findList(init, "streamIds");
+  for (auto item : stream_ids) {
+    std::string id = GetValue<std::string>(item);
+    args.stream_ids.push_back(id.c_str());
+  }
+  EncodableValue direction = findEncodableValue(init, "direction");
+  if (!direction.IsNull())
+    args.direction = GetValue<std::string>(direction);
+  EncodableList encodings = findList(init, "sendEncodings");
+  for (EncodableValue value : encodings) {
+    args.encodings.push_back(DecodeEncoding(GetValue<EncodableMap>(value)));
+  }
+  return args;
+}
+
+SenderParametersArgs DecodeRtpSenderSetParameters(
+    const EncodableValue& arguments) {
+  const EncodableMap params = GetValue<EncodableMap>(arguments);
+  SenderParametersArgs args;
+  args.peer_connection_id = findString(params, "peerConnectionId");
+  args.rtp_sender_id = findString(params, "rtpSenderId");
+  const EncodableMap parameters = findMap(params, "parameters");
+  EncodableList encodings = findList(parameters, "encodings");
+  for (EncodableValue value : encodings) {
+    args.encodings.push_back(DecodeEncoding(GetValue<EncodableMap>(value)));
+  }
+  EncodableValue value =
+      findEncodableValue(parameters, "degradationPreference");
+  if (!value.IsNull())
+    args.degradation_preference = GetValue<std::string>(value);
+  return args;
+}
+
+RendererArgs DecodeVideoRendererSetSrcObject(const EncodableValue& arguments) {
+  const EncodableMap params = GetValue<EncodableMap>(arguments);
+  RendererArgs args;
+  args.stream_id = findString(params, "streamId");
+  args.texture_id = findLongInt(params, "textureId");
+  args.owner_tag = findString(params, "ownerTag");
+  args.track_id = findString(params, "trackId");
+  return args;
+}
+
+}  // namespace legacy
+
+// The way the handlers decode their arguments now.
+namespace current {
+
+EncodingArgs DecodeEncoding(const EncodableMap& params) {
+  EncodingArgs args;
+  const EncodableValue* value = &findEncodableValue(params, keys::kActive);
+  if (!value->IsNull())
+    args.active = GetValue<bool>(*value);
+  value = &findEncodableValue(params, keys::kRid);
+  if (!value->IsNull())
+    args.rid = GetValue<std::string>(*value);
+  value = &findEncodableValue(params, keys::kSsrc);
+  if (!value->IsNull())
+    args.ssrc = GetValue<int>(*value);
+  value = &findEncodableValue(params, keys::kMinBitrate);
+  if (!value->IsNull())
+    args.min_bitrate = GetValue<int>(*value);
+  value = &findEncodableValue(params, keys::kMaxBitrate);
+  if (!value->IsNull())
+    args.max_bitrate = GetValue<int>(*value);
+  value = &findEncodableValue(params, keys::kMaxFramerate);
+  if (!value->IsNull())
+    args.max_framerate = GetValue<int>(*value);
+  value = &findEncodableValue(params, keys::kNumTemporalLayers);
+  if (!value->IsNull())
+    args.num_temporal_layers = GetValue<int>(*value);
+  value = &findEncodableValue(params, keys::kScaleResolutionDownBy);
+  if (!value->IsNull())
+    args.scale_resolution_down_by = GetValue<double>(*value);
+  value = &findEncodableValue(params, keys::kScalabilityMode);
+  if (!value->IsNull())
+    args.scalability_mode = GetValue<std::string>(*value);
+  value = &findEncodableValue(params, keys::kPriority);
+  if (!value->IsNull())
+    args.priority = GetValue<std::string>(*value);
+  value = &findEncodableValue(params, keys::kNetworkPriority);
+  if (!value->IsNull())
+    args.network_priority = GetValue<std::string>(*value);
+  return args;
+}
+
+TransceiverArgs DecodeAddTransceiver(const EncodableValue& arguments) {
+  const EncodableMap& params = GetValue<EncodableMap>(arguments);
+  TransceiverArgs args;
+  args.peer_connection_id = findString(params, keys::kPeerConnectionId);
+  const EncodableMap& init = findMap(params, keys::kTransceiverInit);
+  args.media_type = findString(params, keys::kMediaType);
+  args.track_id = findString(params, keys::kTrackId);
+
+  const EncodableList& stream_ids = findList(init, keys::kStreamIds);
+  for (const auto& item : stream_ids) {
+    const std::string& id = GetValue<std::string>(item);
+    args.stream_ids.push_back(id.c_str());
+  }
+  const EncodableValue& direction = findEncodableValue(init, keys::kDirection);
+  if (!direction.IsNull())
+    args.direction = GetValue<std::string>(direction);
+  const EncodableList& encodings = findList(init, keys::kSendEncodings);
+  for (const EncodableValue& value : encodings) {
+    args.encodings.push_back(DecodeEncoding(GetValue<EncodableMap>(value)));
+  }
+  return args;
+}
+
+SenderParametersArgs DecodeRtpSenderSetParameters(
+    const EncodableValue& arguments) {
+  const EncodableMap& params = GetValue<EncodableMap>(arguments);
+  SenderParametersArgs args;
+  args.peer_connection_id = findString(params, keys::kPeerConnectionId);
+  args.rtp_sender_id = findString(params, keys::kRtpSenderId);
+  const EncodableMap& parameters = findMap(params, keys::kParameters);
+  const EncodableList& encodings = findList(parameters, keys::kEncodings);
+  for (const EncodableValue& value : encodings) {
+    args.encodings.push_back(DecodeEncoding(GetValue<EncodableMap>(value)));
+  }
+  const EncodableValue& value =
+      findEncodableValue(parameters, "degradationPreference");
+  if (!value.IsNull())
+    args.degradation_preference = GetValue<std::string>(value);
+  return args;
+}
+
+RendererArgs DecodeVideoRendererSetSrcObject(const EncodableValue& arguments) {
+  const EncodableMap& params = GetValue<EncodableMap>(arguments);
+  RendererArgs args;
+  args.stream_id = findString(params, keys::kStreamId);
+  args.texture_id = findLongInt(params, "textureId");
+  args.owner_tag = findString(params, "ownerTag");
+  args.track_id = findString(params, keys::kTrackId);
+  return args;
+}
+
+}  // namespace current
+
+template <typename Decode>
+void Compare(const char* method,
+             const EncodableValue& arguments,
+             Decode legacy_decode,
+             Decode current_decode) {
+  double legacy_us = MeasureMicroseconds([&] { legacy_decode(arguments); });
+  double current_us = MeasureMicroseconds([&] { current_decode(arguments); });
+  printf("%-26s %10.0f ns %10.0f ns %7.1fx\n", method, legacy_us * 1000,
+         current_us * 1000, legacy_us / current_us);
+}
+
+}  // namespace
+
+int main() {
+  printf("%-26s %13s %13s %8s\n", "method", "legacy", "current", "speedup");
+  Compare("addTransceiver", EncodableValue(AddTransceiverCall()),
+          legacy::DecodeAddTransceiver, current::DecodeAddTransceiver);
+  Compare("rtpSenderSetParameters",
+          EncodableValue(RtpSenderSetParametersCall()),
+          legacy::DecodeRtpSenderSetParameters,
+          current::DecodeRtpSenderSetParameters);
+  Compare("videoRendererSetSrcObject",
+          EncodableValue(VideoRendererSetSrcObjectCall()),
+          legacy::DecodeVideoRendererSetSrcObject,
+          current::DecodeVideoRendererSetSrcObject);
+  return 0;
+}
@@ -0,0 +1,159 @@
+// Times the plugin's YUV to RGB conversion with each row kernel this CPU can
+// run, next to libwebrtc's RTCVideoFrame::ConvertToARGB where it does the
+// same job.
+
+#include "benchmark_util.h"
+#include "flutter_video_frame_converter.h"
+
+#include "rtc_video_frame.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace flutter_webrtc_benchmarks;
+using namespace flutter_webrtc_plugin;
+
+namespace {
+
+struct FrameSize {
+  const char* name;
+  int width;
+  int height;
+};
+
+const FrameSize kFrameSizes[] = {
+    {"360p", 640, 360},
+    {"720p", 1280, 720},
+    {"1080p", 1920, 1080},
+    {"2160p", 3840, 2160},
+};
+
+const char* const kKernels[] = {"c", "sse4.1", "avx2", "neon"};
+
+// One frame of noise, in both I420 and NV12 layouts.
+struct TestFrame {
+  TestFrame(int width, int height)
+      : width(width),
+        height(height),
+        chroma_width((width + 1) / 2),
+        chroma_height((height + 1) / 2),
+        y(NoiseBytes(static_cast<size_t>(width) * height, 1)),
+        u(NoiseBytes(static_cast<size_t>(chroma_width) * chroma_height, 2)),
+        v(NoiseBytes(static_cast<size_t>(chroma_width) * chroma_height, 3)),
+        uv(u.size() * 2) {
+    for (size_t i = 0; i < u.size(); i++) {
+      uv[i * 2] = u[i];
+      uv[i * 2 + 1] = v[i];
+    }
+  }
+
+  YuvPlanes I420() const {
+    YuvPlanes planes;
+    planes.layout = YuvLayout::kI420;
+    planes.y = y.data();
+    planes.u = u.data();
+    planes.v = v.data();
+    planes.stride_y = width;
+    planes.stride_u = chroma_width;
+    planes.stride_v = chroma_width;
+    planes.width = width;
+    planes.height = height;
+    return planes;
+  }
+
+  YuvPlanes NV12() const {
+    YuvPlanes planes = I420();
+    planes.layout = YuvLayout::kNV12;
+    planes.u = uv.data();
+    planes.v = nullptr;
+    planes.stride_u = chroma_width * 2;
+    planes.stride_v = 0;
+    return planes;
+  }
+
+  int width;
+  int height;
+  int chroma_width;
+  int chroma_height;
+  std::vector<uint8_t> y;
+  std::vector<uint8_t> u;
+  std::vector<uint8_t> v;
+  std::vector<uint8_t> uv;
+};
+
+struct Conversion {
+  const char* name;
+  bool nv12;
+  int rotation;
+  // Output size as a fraction of the frame's.
+  int scale_down;
+};
+
+const Conversion kConversions[] = {
+    {"i420", false, 0, 1},
+    {"nv12", true, 0, 1},
+    {"i420 rotate 90", false, 90, 1},
+    {"i420 scale 1/2", false, 0, 2},
+};
+
+void PrintResult(const char* size,
+                 const char* conversion,
+                 const char* implementation,
+                 int width,
+                 int height,
+                 double microseconds) {
+  printf("%-6s %-15s %-9s %10.1f us %8.1f Mpx/s\n", size, conversion,
+         implementation, microseconds,
+         static_cast<double>(width) * height / microseconds);
+}
+
+}  // namespace
+
+int main() {
+  printf("selected kernel: %s\n\n", YuvToRgbKernelName());
+  printf("%-6s %-15s %-9s %13s %14s\n", "size", "conversion", "kernel",
+         "per frame", "output");
+
+  for (const FrameSize& size : kFrameSizes) {
+    TestFrame frame(size.width, size.height);
+    scoped_refptr<RTCVideoFrame> webrtc_frame = RTCVideoFrame::Create(
+        frame.width, frame.height, frame.y.data(), frame.width,
+        frame.u.data(), frame.chroma_width, frame.v.data(),
+        frame.chroma_width);
+    std::vector<uint8_t> rgba(static_cast<size_t>(size.width) * size.height *
+                              4);
+
+    for (const Conversion& conversion : kConversions) {
+      bool transpose = conversion.rotation == 90 || conversion.rotation == 270;
+      int width =
+          (transpose ? size.height : size.width) / conversion.scale_down;
+      int height =
+          (transpose ? size.width : size.height) / conversion.scale_down;
+      YuvPlanes planes = conversion.nv12 ? frame.NV12() : frame.I420();
+
+      for (const char* kernel : kKernels) {
+        if (!SetYuvToRgbKernel(kernel)) {
+          continue;
+        }
+        double microseconds = MeasureMicroseconds([&] {
+          ConvertYuvToRgb(planes, RgbFormat::kRGBA, conversion.rotation,
+                          rgba.data(), width * 4, width, height);
+        });
+        PrintResult(size.name, conversion.name, kernel, width, height,
+                    microseconds);
+      }
+
+      // ConvertToARGB takes I420 and does not rotate.
+      if (!conversion.nv12 && conversion.rotation == 0) {
+        double microseconds = MeasureMicroseconds([&] {
+          webrtc_frame->ConvertToARGB(RTCVideoFrame::Type::kABGR,
+                                      rgba.data(), width * 4, width, height);
+        });
+        PrintResult(size.name, conversion.name, "libwebrtc", width, height,
+                    microseconds);
+      }
+    }
+    printf("\n");
+  }
+  return 0;
+}
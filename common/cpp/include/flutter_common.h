@@ -16,6 +16,9 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <string_view>
+
+#include "task_runner.h"
 
 typedef flutter::EncodableValue EncodableValue;
 typedef flutter::EncodableMap EncodableMap;
@@ -29,102 +32,180 @@ typedef flutter::EventSink<EncodableValue> EventSink;
 typedef flutter::MethodCall<EncodableValue> MethodCall;
 typedef flutter::MethodResult<EncodableValue> MethodResult;
 
-class TaskRunner;
 
 // foo.StringValue() becomes std::get<std::string>(foo)
 // foo.IsString() becomes std::holds_alternative<std::string>(foo)
 
 template <typename T>
-inline bool TypeIs(const EncodableValue val) {
+inline bool TypeIs(const EncodableValue& val) {
   return std::holds_alternative<T>(val);
 }
 
+// Returns a reference into |val|; copy the result if it has to outlive |val|.
 template <typename T>
-inline const T GetValue(EncodableValue val) {
+inline const T& GetValue(const EncodableValue& val) {
   return std::get<T>(val);
 }
 
-inline EncodableValue findEncodableValue(const EncodableMap& map,
-                                         const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end())
-    return it->second;
-  return EncodableValue();
+// EncodableMap's comparator is not transparent, so a lookup needs the key as
+// an EncodableValue. Keys looked up on hot paths are interned in |keys|
+// below; any other key is copied into a per-thread scratch value whose buffer
+// is reused, so no lookup allocates once that buffer has grown.
+inline const EncodableValue* findEntry(const EncodableMap& map,
+                                       const EncodableValue& key) {
+  auto it = map.find(key);
+  return it != map.end() ? &it->second : nullptr;
+}
+
+// A template rather than a std::string_view overload, which would make
+// string literals ambiguous: EncodableValue inherits std::variant's implicit
+// converting constructor.
+template <typename Key>
+inline const EncodableValue* findEntry(const EncodableMap& map,
+                                       const Key& key) {
+  thread_local EncodableValue scratch{std::string()};
+  std::string_view name(key);
+  std::get<std::string>(scratch).assign(name.data(), name.size());
+  return findEntry(map, scratch);
 }
 
-inline EncodableMap findMap(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<EncodableMap>(it->second))
-    return GetValue<EncodableMap>(it->second);
-  return EncodableMap();
+namespace flutter_webrtc_plugin {
+// Map keys shared by the method handlers and the events, interned so that
+// neither builds a std::string per lookup or per event.
+namespace keys {
+inline const EncodableValue kActive{"active"};
+inline const EncodableValue kCandidate{"candidate"};
+inline const EncodableValue kData{"data"};
+inline const EncodableValue kDirection{"direction"};
+inline const EncodableValue kEncodings{"encodings"};
+inline const EncodableValue kEvent{"event"};
+inline const EncodableValue kHeight{"height"};
+inline const EncodableValue kId{"id"};
+inline const EncodableValue kMaxBitrate{"maxBitrate"};
+inline const EncodableValue kMaxFramerate{"maxFramerate"};
+inline const EncodableValue kMediaType{"mediaType"};
+inline const EncodableValue kMinBitrate{"minBitrate"};
+inline const EncodableValue kNetworkPriority{"networkPriority"};
+inline const EncodableValue kNumTemporalLayers{"numTemporalLayers"};
+inline const EncodableValue kParameters{"parameters"};
+inline const EncodableValue kParticipantId{"participantId"};
+inline const EncodableValue kPeerConnectionId{"peerConnectionId"};
+inline const EncodableValue kPriority{"priority"};
+inline const EncodableValue kRid{"rid"};
+inline const EncodableValue kRotation{"rotation"};
+inline const EncodableValue kRtpSenderId{"rtpSenderId"};
+inline const EncodableValue kScalabilityMode{"scalabilityMode"};
+inline const EncodableValue kScaleResolutionDownBy{"scaleResolutionDownBy"};
+inline const EncodableValue kSdpMLineIndex{"sdpMLineIndex"};
+inline const EncodableValue kSdpMid{"sdpMid"};
+inline const EncodableValue kSendEncodings{"sendEncodings"};
+inline const EncodableValue kSsrc{"ssrc"};
+inline const EncodableValue kState{"state"};
+inline const EncodableValue kStreamId{"streamId"};
+inline const EncodableValue kStreamIds{"streamIds"};
+inline const EncodableValue kTrackId{"trackId"};
+inline const EncodableValue kTransceiverId{"transceiverId"};
+inline const EncodableValue kTransceiverInit{"transceiverInit"};
+inline const EncodableValue kType{"type"};
+inline const EncodableValue kWidth{"width"};
+}  // namespace keys
+}  // namespace flutter_webrtc_plugin
+
+// The find* helpers below take either kind of key. They return references
+// into |map|, or to a shared empty value when |key| is missing or holds
+// another type, so looking up a large payload never copies it. Copy the
+// result if it has to outlive |map|.
+
+template <typename Key>
+inline const EncodableValue& findEncodableValue(const EncodableMap& map,
+                                                const Key& key) {
+  static const EncodableValue kEmpty;
+  const EncodableValue* value = findEntry(map, key);
+  return value ? *value : kEmpty;
 }
 
-inline EncodableList findList(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<EncodableList>(it->second))
-    return GetValue<EncodableList>(it->second);
-  return EncodableList();
+template <typename Key>
+inline const EncodableMap& findMap(const EncodableMap& map, const Key& key) {
+  static const EncodableMap kEmpty;
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<EncodableMap>(*value))
+    return GetValue<EncodableMap>(*value);
+  return kEmpty;
 }
 
-inline std::string findString(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<std::string>(it->second))
-    return GetValue<std::string>(it->second);
-  return std::string();
+template <typename Key>
+inline const EncodableList& findList(const EncodableMap& map, const Key& key) {
+  static const EncodableList kEmpty;
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<EncodableList>(*value))
+    return GetValue<EncodableList>(*value);
+  return kEmpty;
 }
 
-inline int findInt(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<int>(it->second))
-    return GetValue<int>(it->second);
+template <typename Key>
+inline const std::string& findString(const EncodableMap& map, const Key& key) {
+  static const std::string kEmpty;
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<std::string>(*value))
+    return GetValue<std::string>(*value);
+  return kEmpty;
+}
+
+template <typename Key>
+inline int findInt(const EncodableMap& map, const Key& key) {
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<int>(*value))
+    return GetValue<int>(*value);
   return -1;
 }
 
-inline bool findBoolean(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<bool>(it->second))
-    return GetValue<bool>(it->second);
+template <typename Key>
+inline bool findBoolean(const EncodableMap& map, const Key& key) {
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<bool>(*value))
+    return GetValue<bool>(*value);
   return false;
 }
 
-inline double findDouble(const EncodableMap& map, const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<double>(it->second))
-    return GetValue<double>(it->second);
+template <typename Key>
+inline double findDouble(const EncodableMap& map, const Key& key) {
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<double>(*value))
+    return GetValue<double>(*value);
   return 0.0;
 }
 
+template <typename Key>
 inline std::optional<double> maybeFindDouble(const EncodableMap& map,
-                                             const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<double>(it->second))
-    return GetValue<double>(it->second);
+                                             const Key& key) {
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<double>(*value))
+    return GetValue<double>(*value);
   return std::nullopt;
 }
 
-inline std::vector<uint8_t> findVector(const EncodableMap& map,
-                                       const std::string& key) {
-  auto it = map.find(EncodableValue(key));
-  if (it != map.end() && TypeIs<std::vector<uint8_t>>(it->second))
-    return GetValue<std::vector<uint8_t>>(it->second);
-  return std::vector<uint8_t>();
+template <typename Key>
+inline const std::vector<uint8_t>& findVector(const EncodableMap& map,
+                                              const Key& key) {
+  static const std::vector<uint8_t> kEmpty;
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<std::vector<uint8_t>>(*value))
+    return GetValue<std::vector<uint8_t>>(*value);
+  return kEmpty;
 }
 
-inline int64_t findLongInt(const EncodableMap& map, const std::string& key) {
-  for (auto it : map) {
-    if (key == GetValue<std::string>(it.first)) {
-      if (TypeIs<int64_t>(it.second)) {
-        return GetValue<int64_t>(it.second);
-      } else if (TypeIs<int32_t>(it.second)) {
-        return GetValue<int32_t>(it.second);
-      }
-    }
-  }
-
+// The codec sends integers as int32 or int64 depending on their magnitude.
+template <typename Key>
+inline int64_t findLongInt(const EncodableMap& map, const Key& key) {
+  const EncodableValue* value = findEntry(map, key);
+  if (value && TypeIs<int64_t>(*value))
+    return GetValue<int64_t>(*value);
+  if (value && TypeIs<int32_t>(*value))
+    return GetValue<int32_t>(*value);
   return -1;
 }
 
-inline int toInt(flutter::EncodableValue inputVal, int defaultVal) {
+inline int toInt(const EncodableValue& inputVal, int defaultVal) {
   int intValue = defaultVal;
   if (TypeIs<int>(inputVal)) {
     intValue = GetValue<int>(inputVal);
@@ -173,17 +254,48 @@ class MethodResultProxy {
   virtual void NotImplemented() = 0;
 };
 
+// What an EventChannelProxy drops when its buffer of events waiting for a
+// listener is full.
+enum class EventDropPolicy {
+  kDropOldest,
+  // Drops the event that does not fit. A few slots are kept for events sent
+  // with SuccessState(), so that those are not lost behind a burst of others.
+  kDropNewest,
+  // Buffers only the newest event of each name, replacing the older one, and
+  // drops the oldest event when full. For channels whose events report state.
+  kCoalesce,
+};
+
 class EventChannelProxy {
  public:
+  // Events are posted through |task_runner| in the lane of |priority|. A
+  // listener that passes {"batchEvents": true} as its arguments receives
+  // every message as a list of one or more events.
+  //
+  // Until someone listens, events are kept in a bounded buffer, handled by
+  // |drop_policy| when full, and sent in one go when a listener attaches.
   static std::unique_ptr<EventChannelProxy> Create(
       BinaryMessenger* messenger,
       TaskRunner* task_runner,
-      const std::string& channelName);
+      const std::string& channelName,
+      TaskPriority priority = TaskPriority::kMediaEvents,
+      EventDropPolicy drop_policy = EventDropPolicy::kDropOldest);
 
   virtual ~EventChannelProxy() = default;
 
-  virtual void Success(const EncodableValue& event,
-                       bool cache_event = true) = 0;
+  // Takes |event| by value so that a temporary is moved, not copied, all
+  // the way into the task that sends it.
+  virtual void Success(EncodableValue event, bool cache_event = true) = 0;
+
+  // Like Success(), for the few events that report a change of state, such
+  // as a data channel opening or closing. Under kDropNewest they are
+  // buffered even when other events no longer are.
+  virtual void SuccessState(EncodableValue event) = 0;
+
+  // Events buffered while no one listened, and those dropped from or
+  // coalesced in that buffer. Reported by getEventChannelStats.
+  virtual uint64_t queued_events() const = 0;
+  virtual uint64_t dropped_events() const = 0;
 };
 
 #endif  // FLUTTER_WEBRTC_COMMON_HXX
@@ -20,6 +20,10 @@ class FlutterRTCDataChannelObserver : public RTCDataChannelObserver {
 
   scoped_refptr<RTCDataChannel> data_channel() { return data_channel_; }
 
+  const EventChannelProxy* event_channel() const {
+    return event_channel_.get();
+  }
+
  private:
   std::unique_ptr<EventChannelProxy> event_channel_;
   scoped_refptr<RTCDataChannel> data_channel_;
@@ -2,6 +2,7 @@
 #define FLUTTER_WEBRTC_RTC_DATA_PACKET_CRYPTOR_HXX
 
 #include "flutter_common.h"
+#include "flutter_method_dispatcher.h"
 #include "flutter_webrtc_base.h"
 
 #include "rtc_data_packet_cryptor.h"
@@ -12,10 +13,7 @@ class FlutterDataPacketCryptor {
  public:
   FlutterDataPacketCryptor(FlutterWebRTCBase* base) : base_(base) {}
 
-  bool HandleDataPacketCryptorMethodCall(
-      const MethodCallProxy& method_call,
-      std::unique_ptr<MethodResultProxy> result,
-      std::unique_ptr<MethodResultProxy> *outResult);
+  void RegisterDataPacketCryptorMethods(FlutterMethodDispatcher* dispatcher);
 
   void CreateDataPacketCryptor(const EncodableMap& constraints,
                                std::unique_ptr<MethodResultProxy> result);
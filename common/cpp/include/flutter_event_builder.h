@@ -0,0 +1,49 @@
+#ifndef FLUTTER_WEBRTC_RTC_EVENT_BUILDER_HXX
+#define FLUTTER_WEBRTC_RTC_EVENT_BUILDER_HXX
+
+#include "flutter_common.h"
+
+#include <utility>
+
+namespace flutter_webrtc_plugin {
+
+// Fills in one event map. Values are moved into place, since
+// EncodableValue's converting constructor copies its argument, and keys
+// come from the interned constants in |keys| (flutter_common.h).
+class EventBuilder {
+ public:
+  explicit EventBuilder(const EncodableValue& event) : event_(event) {}
+
+  template <typename T>
+  EventBuilder& Set(const EncodableValue& key, T&& value) {
+    std::get<EncodableMap>(event_)[key] = std::forward<T>(value);
+    return *this;
+  }
+
+  EncodableValue Build() { return std::move(event_); }
+
+ private:
+  EncodableValue event_;
+};
+
+// One kind of event sent on an event channel: a map already holding the
+// event's name under "event". Keep one as a static per kind of event, and
+// start every occurrence from it, so that building an event only allocates
+// the map's nodes and the payload.
+class EventTemplate {
+ public:
+  explicit EventTemplate(const char* name) {
+    EncodableMap map;
+    map[keys::kEvent] = name;
+    event_ = std::move(map);
+  }
+
+  EventBuilder New() const { return EventBuilder(event_); }
+
+ private:
+  EncodableValue event_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_EVENT_BUILDER_HXX
@@ -2,34 +2,108 @@
 #define FLUTTER_WEBRTC_RTC_FRAME_CAPTURER_HXX
 
 #include "flutter_common.h"
+#include "flutter_image_encoder.h"
 #include "flutter_webrtc_base.h"
 
 #include "rtc_video_frame.h"
 #include "rtc_video_renderer.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace flutter_webrtc_plugin {
 
 using namespace libwebrtc;
 
+class FlutterFrameCapturer;
+
+// The thread that finishes captures for the plugin. It waits for every
+// pending capture at once, until its frame arrives or its timeout passes, then
+// encodes it and replies. Captures still pending when the worker is destroyed
+// are cancelled, and the thread is joined.
+class FrameCaptureWorker {
+ public:
+  FrameCaptureWorker();
+  ~FrameCaptureWorker();
+
+  void Add(std::shared_ptr<FlutterFrameCapturer> capturer,
+           std::shared_ptr<MethodResultProxy> result,
+           std::chrono::milliseconds timeout);
+
+  // Called when a pending capturer has received its frame.
+  void Wake();
+
+ private:
+  struct Capture {
+    std::shared_ptr<FlutterFrameCapturer> capturer;
+    std::shared_ptr<MethodResultProxy> result;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  void Run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::list<Capture> captures_;
+  bool woken_ = false;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+// Grabs the next frame of a video track and encodes it as a PNG, JPEG or QOI
+// image without blocking the platform thread, then either saves it to a file
+// or returns the encoded bytes. The worker keeps the capturer alive until the
+// capture completes.
 class FlutterFrameCapturer
-    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>> {
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>>,
+      public std::enable_shared_from_this<FlutterFrameCapturer> {
  public:
-  FlutterFrameCapturer(RTCVideoTrack* track, std::string path);
+  // An empty |path| returns the image as a byte array. Frames larger than
+  // |max_width| x |max_height| are scaled down to fit while they are
+  // converted; zero leaves that dimension unbounded.
+  FlutterFrameCapturer(scoped_refptr<RTCVideoTrack> track,
+                       std::string path,
+                       ImageFormat format,
+                       int quality,
+                       size_t max_width,
+                       size_t max_height,
+                       FrameCaptureWorker* worker);
 
   virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
 
-  void CaptureFrame(std::unique_ptr<MethodResultProxy> result);
+  // Waits up to |timeout| for the next frame on the worker, encodes it there
+  // and reports the outcome to |result|, which posts the reply back to the
+  // platform thread itself.
+  void CaptureFrame(std::unique_ptr<MethodResultProxy> result,
+                    std::chrono::milliseconds timeout);
+
+  bool HasFrame();
+
+  // Called on the worker once the frame has arrived or the timeout passed.
+  void Finish(std::shared_ptr<MethodResultProxy> result);
+
+  // Called on the worker when it stops before the capture is finished.
+  void Cancel(std::shared_ptr<MethodResultProxy> result);
 
  private:
-  RTCVideoTrack* track_;
+  scoped_refptr<RTCVideoTrack> track_;
   std::string path_;
+  ImageFormat format_;
+  int quality_;
+  size_t max_width_;
+  size_t max_height_;
+  FrameCaptureWorker* worker_;
   std::mutex mutex_;
   scoped_refptr<RTCVideoFrame> frame_;
-  volatile bool catch_frame_;
 
-  bool SaveFrame();
+  std::vector<uint8_t> EncodeFrame(scoped_refptr<RTCVideoFrame> frame);
+
+  bool WriteToFile(const std::vector<uint8_t>& image);
 };
 
 }  // namespace flutter_webrtc_plugin
@@ -2,6 +2,7 @@
 #define FLUTTER_WEBRTC_RTC_FRAME_CRYPTOR_HXX
 
 #include "flutter_common.h"
+#include "flutter_method_dispatcher.h"
 #include "flutter_webrtc_base.h"
 
 #include "rtc_frame_cryptor.h"
@@ -27,11 +28,7 @@ class FlutterFrameCryptor {
  public:
   FlutterFrameCryptor(FlutterWebRTCBase* base) : base_(base) {}
 
-  // Since this takes ownership of result, ownership will be passed back to 'outResult' if this function fails
-  bool HandleFrameCryptorMethodCall(
-    const MethodCallProxy& method_call,
-    std::unique_ptr<MethodResultProxy> result,
-    std::unique_ptr<MethodResultProxy> *outResult);
+  void RegisterFrameCryptorMethods(FlutterMethodDispatcher* dispatcher);
 
   void FrameCryptorFactoryCreateFrameCryptor(
       const EncodableMap& constraints,
@@ -0,0 +1,111 @@
+#ifndef FLUTTER_WEBRTC_RTC_FRAME_DUMP_HXX
+#define FLUTTER_WEBRTC_RTC_FRAME_DUMP_HXX
+
+#include "flutter_common.h"
+#include "flutter_media_recorder.h"
+#include "flutter_webrtc_base.h"
+
+#include "rtc_video_frame.h"
+#include "rtc_video_renderer.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Dumps the frames of a video track, as delivered to its renderers, to a Y4M
+// file for offline quality analysis (PSNR, VMAF). Every frame that arrives is
+// written once, as decoded: neither rotated nor scaled. The Y4M header's
+// 30 fps is nominal. A change of frame size starts a new Y4M segment next to
+// the first, "<name>.<n><extension>" (see Y4mWriter).
+//
+// A sidecar text file "<path>.timestamps" gets one line per written frame:
+//   <frame index> <arrival time in microseconds> <width> <height> <rotation>
+// Arrival times count from Start(); frame indices run on across segments.
+//
+// Frames are copied into a ring of reusable buffers and written on a thread
+// of its own. If that thread falls behind, frames are dropped and counted,
+// and the gap shows in the sidecar's arrival times.
+class FlutterFrameDump
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>> {
+ public:
+  // Stops accepting frames after |max_frames|; zero means no limit.
+  FlutterFrameDump(scoped_refptr<RTCVideoTrack> track,
+                   std::string path,
+                   int64_t max_frames);
+  ~FlutterFrameDump();
+
+  // Creates the dump and its sidecar and attaches to the track. Returns
+  // false, leaving no files behind, if either cannot be created.
+  bool Start();
+  // Detaches from the track, writes what is queued and closes the files.
+  // Returns false if any write failed.
+  bool Stop();
+
+  virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
+
+  int64_t frames_written() const { return frames_written_; }
+  size_t segments() const { return y4m_.segments().size(); }
+  uint64_t frames_dropped() const { return frames_dropped_; }
+
+ private:
+  static constexpr size_t kQueueFrames = 16;
+
+  void WriterLoop();
+  bool Drain();
+
+  scoped_refptr<RTCVideoTrack> track_;
+  std::string path_;
+  int64_t max_frames_;
+  std::chrono::steady_clock::time_point start_time_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  bool work_pending_ = false;
+  // Set when a write fails. No frame is queued or written after that; Stop()
+  // reports it.
+  bool failed_ = false;
+  std::unique_ptr<VideoFrameQueue> queue_;
+  int64_t frames_accepted_ = 0;
+  uint64_t frames_dropped_ = 0;
+
+  // Writer thread only.
+  Y4mWriter y4m_;
+  FILE* timestamps_ = nullptr;
+  int64_t frames_written_ = 0;
+
+  std::thread writer_;
+};
+
+class FlutterFrameDumpManager {
+ public:
+  FlutterFrameDumpManager(FlutterWebRTCBase* base);
+  ~FlutterFrameDumpManager();
+
+  // Dumps the video track "trackId" to "path", stopping after "maxFrames"
+  // frames when set.
+  void StartFrameDump(const EncodableMap& params,
+                      std::unique_ptr<MethodResultProxy> result);
+
+  // Returns the number of "frames" written and "dropped", and of Y4M
+  // "segments".
+  void StopFrameDump(const std::string& track_id,
+                     std::unique_ptr<MethodResultProxy> result);
+
+ private:
+  FlutterWebRTCBase* base_;
+  std::map<std::string, std::unique_ptr<FlutterFrameDump>> dumps_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_FRAME_DUMP_HXX
@@ -0,0 +1,104 @@
+#ifndef FLUTTER_WEBRTC_RTC_FRAME_TAP_HXX
+#define FLUTTER_WEBRTC_RTC_FRAME_TAP_HXX
+
+#include "flutter_common.h"
+#include "flutter_webrtc_base.h"
+
+#include "rtc_video_frame.h"
+#include "rtc_video_renderer.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Delivers frames of a video track to Dart at a capped rate and a fixed
+// size, as raw binary messages on a channel of its own.
+//
+// Every message is a little-endian header followed by tightly packed rows:
+//   uint32 width, uint32 height, uint8 format (0 = RGB, 1 = Y only),
+//   3 bytes padding, uint32 sequence number, int64 capture time in
+//   microseconds since the Unix epoch.
+// The sequence number advances for every frame that passes the rate cap, so
+// gaps show frames skipped because the previous one was still being sent.
+//
+// The message buffer is reused for every frame and only reallocated when the
+// source size changes.
+class FlutterFrameTap
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>>,
+      public std::enable_shared_from_this<FlutterFrameTap> {
+ public:
+  enum class Format : uint8_t {
+    kRGB = 0,
+    kLuma = 1,
+  };
+
+  static constexpr size_t kHeaderSize = 24;
+
+  // Frames are scaled to |width| x |height|. With only one of them set the
+  // other follows the aspect ratio, and with neither the frame keeps its
+  // size. |fps| caps the delivery rate; zero delivers every frame.
+  FlutterFrameTap(scoped_refptr<RTCVideoTrack> track,
+                  BinaryMessenger* messenger,
+                  TaskRunner* task_runner,
+                  std::string channel,
+                  double fps,
+                  size_t width,
+                  size_t height,
+                  Format format);
+
+  void Start();
+  void Stop();
+
+  virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
+
+ private:
+  bool ShouldDropFrame();
+  void FillMessage(scoped_refptr<RTCVideoFrame> frame, uint32_t sequence);
+  void Send();
+
+  scoped_refptr<RTCVideoTrack> track_;
+  BinaryMessenger* messenger_;
+  TaskRunner* task_runner_;
+  std::string channel_;
+  std::chrono::steady_clock::duration interval_;
+  size_t width_;
+  size_t height_;
+  Format format_;
+  std::chrono::steady_clock::time_point next_frame_time_;
+
+  std::mutex mutex_;
+  // Set while |message_| is being filled or sent.
+  bool busy_ = false;
+  std::vector<uint8_t> message_;
+  std::vector<uint8_t> rgba_;
+  uint32_t sequence_ = 0;
+};
+
+class FlutterFrameTapManager {
+ public:
+  FlutterFrameTapManager(FlutterWebRTCBase* base);
+  ~FlutterFrameTapManager();
+
+  // Starts a tap on |track| configured by |params| ("fps", "width", "height"
+  // and "format": "rgb" or "y") and returns its "tapId" and "channel".
+  void StartFrameTap(scoped_refptr<RTCVideoTrack> track,
+                     const EncodableMap& params,
+                     std::unique_ptr<MethodResultProxy> result);
+
+  void StopFrameTap(const std::string& tap_id,
+                    std::unique_ptr<MethodResultProxy> result);
+
+ private:
+  FlutterWebRTCBase* base_;
+  std::map<std::string, std::shared_ptr<FlutterFrameTap>> taps_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_FRAME_TAP_HXX
@@ -0,0 +1,35 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_IMAGE_ENCODER_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_IMAGE_ENCODER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flutter_webrtc_plugin {
+
+enum class ImageFormat {
+  kPNG,
+  kJPEG,
+  kQOI,
+};
+
+// Parses "png", "jpeg"/"jpg" or "qoi". Returns false for anything else.
+bool ParseImageFormat(const std::string& name, ImageFormat* format);
+
+// Encodes a 32-bit RGBA image as an opaque RGB |format| image. |quality|
+// (1-100) only applies to JPEG.
+//
+// Rows are split into bands that are encoded on separate threads and then
+// joined without re-encoding: deflate streams are byte-aligned with an empty
+// stored block after each band, JPEG bands are separated by restart markers,
+// and QOI bands start from the pixel before them with an empty color index.
+std::vector<uint8_t> EncodeImage(const uint8_t* rgba,
+                                 int width,
+                                 int height,
+                                 int stride,
+                                 ImageFormat format,
+                                 int quality);
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_IMAGE_ENCODER_H_
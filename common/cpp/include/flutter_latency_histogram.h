@@ -0,0 +1,78 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_LATENCY_HISTOGRAM_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_LATENCY_HISTOGRAM_H_
+
+#include "flutter_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace flutter_webrtc_plugin {
+
+// Lock-free histogram of durations, safe to record from any thread.
+// Buckets roughly double from 0.5 ms up to two frames at 30 fps, the last
+// one catching everything slower.
+class LatencyHistogram {
+ public:
+  static constexpr int kBucketCount = 9;
+
+  void Record(std::chrono::steady_clock::duration duration) {
+    int64_t micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count();
+    if (micros < 0) {
+      micros = 0;
+    }
+    int bucket = 0;
+    while (bucket < kBucketCount - 1 && micros >= kBucketBoundsUs[bucket]) {
+      bucket++;
+    }
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_us_.fetch_add(micros, std::memory_order_relaxed);
+    int64_t max = max_us_.load(std::memory_order_relaxed);
+    while (micros > max && !max_us_.compare_exchange_weak(
+                               max, micros, std::memory_order_relaxed)) {
+    }
+  }
+
+  int64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  // {count, meanMs, maxMs, bucketBoundsMs, buckets}. bucketBoundsMs holds the
+  // exclusive upper bound of every bucket but the last.
+  EncodableMap ToMap() const {
+    EncodableList bounds;
+    EncodableList buckets;
+    for (int i = 0; i < kBucketCount; i++) {
+      if (i < kBucketCount - 1) {
+        bounds.push_back(EncodableValue(kBucketBoundsUs[i] / 1000.0));
+      }
+      buckets.push_back(EncodableValue(static_cast<int64_t>(
+          buckets_[i].load(std::memory_order_relaxed))));
+    }
+    int64_t count = count_.load(std::memory_order_relaxed);
+    int64_t total_us = total_us_.load(std::memory_order_relaxed);
+    EncodableMap map;
+    map[EncodableValue("count")] = EncodableValue(count);
+    map[EncodableValue("meanMs")] =
+        EncodableValue(count > 0 ? total_us / 1000.0 / count : 0.0);
+    map[EncodableValue("maxMs")] =
+        EncodableValue(max_us_.load(std::memory_order_relaxed) / 1000.0);
+    map[EncodableValue("bucketBoundsMs")] = EncodableValue(bounds);
+    map[EncodableValue("buckets")] = EncodableValue(buckets);
+    return map;
+  }
+
+ private:
+  static constexpr int64_t kBucketBoundsUs[kBucketCount - 1] = {
+      500, 1000, 2000, 4000, 8000, 16000, 33000, 66000};
+
+  std::atomic<int64_t> buckets_[kBucketCount] = {};
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> total_us_{0};
+  std::atomic<int64_t> max_us_{0};
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,223 @@
+#ifndef FLUTTER_WEBRTC_RTC_MEDIA_RECORDER_HXX
+#define FLUTTER_WEBRTC_RTC_MEDIA_RECORDER_HXX
+
+#include "flutter_common.h"
+#include "flutter_webrtc_base.h"
+
+#include "rtc_audio_track.h"
+#include "rtc_video_frame.h"
+#include "rtc_video_renderer.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// Bounded queue of I420 frames, for handing frames from a track's sink to a
+// writer thread. Push() copies the planes as they are, without rotating or
+// scaling them, into a free slot and never blocks, so a slow disk drops
+// frames instead of stalling the decoder. Slot buffers are reused, and only
+// grow when a larger frame arrives.
+class VideoFrameQueue {
+ public:
+  struct Frame {
+    // Tightly packed I420.
+    std::vector<uint8_t> data;
+    int width = 0;
+    int height = 0;
+    int rotation = 0;
+    int64_t timestamp_us = 0;
+  };
+
+  explicit VideoFrameQueue(size_t capacity);
+
+  // Copies |frame| into a free slot. Returns false, dropping the frame, when
+  // every slot is taken.
+  bool Push(RTCVideoFrame* frame, int64_t timestamp_us);
+
+  // The oldest queued frame, or nullptr. It stays valid, and is not touched
+  // by Push(), until Pop().
+  const Frame* Front();
+  void Pop();
+
+ private:
+  std::mutex mutex_;
+  std::vector<Frame> slots_;
+  size_t head_ = 0;
+  size_t count_ = 0;
+};
+
+// Writes raw YUV4MPEG2 (4:2:0) streams. A Y4M stream has a single frame
+// size, so each size gets a segment of its own: the first is written to the
+// path given to Open(), later ones next to it as "<name>.<n><extension>".
+// Open() only creates the first file, so that it can fail before any frame
+// arrives; StartSegment() writes the header, which needs the frame size.
+class Y4mWriter {
+ public:
+  ~Y4mWriter();
+
+  bool Open(const std::string& path);
+  // Starts a segment of |width| x |height| frames, in the file Open()
+  // created if it is still empty and in a new file otherwise.
+  bool StartSegment(int width, int height, int fps);
+  bool WriteFrame(const uint8_t* i420, size_t size);
+  bool Close();
+
+  // Size of the current segment's frames; zero before the first.
+  int width() const { return width_; }
+  int height() const { return height_; }
+  // Path of every segment, from the file Open() created on.
+  const std::vector<std::string>& segments() const { return segments_; }
+
+ private:
+  std::string path_;
+  FILE* file_ = nullptr;
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<std::string> segments_;
+};
+
+// Writes 16-bit PCM to a WAV file. Open() reserves room for the header,
+// which Close() fills in with the format and sizes.
+class WavWriter {
+ public:
+  ~WavWriter();
+
+  bool Open(const std::string& path);
+  void SetFormat(int sample_rate, int channels);
+  bool Write(const int16_t* samples, size_t count);
+  bool Close();
+
+ private:
+  FILE* file_ = nullptr;
+  int sample_rate_ = 0;
+  int channels_ = 0;
+  uint32_t data_bytes_ = 0;
+};
+
+// Records a video track to Y4M and an audio track to WAV. The sinks only copy
+// into bounded queues; a dedicated thread does all file I/O.
+//
+// Y4M has no timestamps, so video is written at a constant kFrameRate,
+// repeating or skipping frames to follow their capture times. Frames are
+// written as decoded, without applying their rotation; a change of frame
+// size starts a new Y4M segment (see Y4mWriter).
+class FlutterMediaRecorder
+    : public RTCVideoRenderer<scoped_refptr<RTCVideoFrame>>,
+      public AudioTrackSink {
+ public:
+  static constexpr int kFrameRate = 30;
+
+  FlutterMediaRecorder(scoped_refptr<RTCVideoTrack> video_track,
+                       std::string video_path,
+                       scoped_refptr<RTCAudioTrack> audio_track,
+                       std::string audio_path);
+  ~FlutterMediaRecorder();
+
+  // Creates the output files and attaches to the tracks. Returns false,
+  // leaving no files behind, if a file cannot be created.
+  bool Start();
+  // Detaches from the tracks, flushes what is queued and closes the files.
+  // Returns false if any write failed.
+  bool Stop();
+
+  virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
+
+  virtual void OnData(const void* audio_data,
+                      int bits_per_sample,
+                      int sample_rate,
+                      size_t number_of_channels,
+                      size_t number_of_frames) override;
+
+  uint64_t video_frames_dropped() const { return video_frames_dropped_; }
+  uint64_t audio_chunks_dropped() const { return audio_chunks_dropped_; }
+  // Every Y4M file the video went to; only stable once stopped.
+  const std::vector<std::string>& video_segments() const {
+    return y4m_.segments();
+  }
+
+ private:
+  // Queued video and audio; enough to ride out a brief disk stall.
+  static constexpr size_t kVideoQueueFrames = 8;
+  static constexpr int kAudioQueueMs = 2000;
+
+  void WriterLoop();
+  bool DrainVideo();
+  bool DrainAudio();
+
+  scoped_refptr<RTCVideoTrack> video_track_;
+  std::string video_path_;
+  scoped_refptr<RTCAudioTrack> audio_track_;
+  std::string audio_path_;
+  std::chrono::steady_clock::time_point start_time_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  // Set by the sinks when they queue something for the writer.
+  bool work_pending_ = false;
+  // Set when a write fails. Nothing is queued or written after that; Stop()
+  // reports it.
+  bool failed_ = false;
+  std::unique_ptr<VideoFrameQueue> video_queue_;
+  // Ring of interleaved samples, sized on the first chunk.
+  std::vector<int16_t> audio_ring_;
+  size_t audio_head_ = 0;
+  size_t audio_count_ = 0;
+  int audio_sample_rate_ = 0;
+  int audio_channels_ = 0;
+  uint64_t video_frames_dropped_ = 0;
+  uint64_t audio_chunks_dropped_ = 0;
+
+  // Writer thread only.
+  Y4mWriter y4m_;
+  WavWriter wav_;
+  // Capture time of the first frame of the current segment.
+  int64_t first_video_us_ = 0;
+  // Frames written to the current segment.
+  int64_t frames_written_ = 0;
+  std::vector<int16_t> audio_scratch_;
+
+  std::thread writer_;
+};
+
+class FlutterMediaRecorderManager {
+ public:
+  FlutterMediaRecorderManager(FlutterWebRTCBase* base);
+  ~FlutterMediaRecorderManager();
+
+  // Records the video track "videoTrackId" to "path" and, when
+  // "audioChannel" is set, the microphone (0) or the remote audio of
+  // "peerConnectionId" (1) to a .wav next to it.
+  void StartRecordToFile(const EncodableMap& params,
+                         std::unique_ptr<MethodResultProxy> result);
+
+  void StopRecordToFile(int64_t recorder_id,
+                        std::unique_ptr<MethodResultProxy> result);
+
+ private:
+  scoped_refptr<RTCAudioTrack> FindAudioTrack(
+      int audio_channel,
+      const std::string& peer_connection_id);
+
+  FlutterWebRTCBase* base_;
+  struct Recording {
+    std::unique_ptr<FlutterMediaRecorder> recorder;
+    std::string video_path;
+    std::string audio_path;
+  };
+  std::map<int64_t, Recording> recorders_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_MEDIA_RECORDER_HXX
@@ -0,0 +1,63 @@
+#ifndef FLUTTER_WEBRTC_RTC_METHOD_DISPATCHER_HXX
+#define FLUTTER_WEBRTC_RTC_METHOD_DISPATCHER_HXX
+
+#include "flutter_common.h"
+#include "flutter_latency_histogram.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace flutter_webrtc_plugin {
+
+// Routes method calls to handlers registered by name, with one hash lookup
+// per call, and times every method.
+//
+// For each method it keeps two histograms: how long the handler ran on the
+// platform thread, and how long until the result was reported, which for
+// asynchronous methods includes the time spent off that thread.
+class FlutterMethodDispatcher {
+ public:
+  using MethodHandler =
+      std::function<void(const MethodCallProxy& method_call,
+                         std::unique_ptr<MethodResultProxy> result)>;
+  using ParamsHandler =
+      std::function<void(const EncodableMap& params,
+                         std::unique_ptr<MethodResultProxy> result)>;
+
+  // Handlers must all be registered before the first call is dispatched.
+  void Register(const std::string& method, MethodHandler handler);
+
+  // Registers a handler for a method that requires a map of arguments,
+  // failing calls that come without one.
+  void RegisterWithParams(const std::string& method, ParamsHandler handler);
+
+  // Reports NotImplemented for methods without a handler.
+  void Dispatch(const MethodCallProxy& method_call,
+                std::unique_ptr<MethodResultProxy> result);
+
+  // Dispatches each {"method", "args"} map of |calls| in order, and replies
+  // once all of them have, with a list holding for each call either
+  // {"result"} or {"error", "message", "details"}. A call that is not
+  // implemented gets the error code "notImplemented".
+  void DispatchBatch(const EncodableList& calls,
+                     std::unique_ptr<MethodResultProxy> result);
+
+  // {method: {handler, reply}} for every method called at least once, each
+  // histogram in LatencyHistogram::ToMap() form.
+  EncodableMap MethodStats() const;
+
+ private:
+  struct Method {
+    MethodHandler handler;
+    LatencyHistogram handler_time;
+    LatencyHistogram reply_time;
+  };
+
+  std::unordered_map<std::string, Method> methods_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // !FLUTTER_WEBRTC_RTC_METHOD_DISPATCHER_HXX
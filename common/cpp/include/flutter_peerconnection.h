@@ -2,6 +2,7 @@
 #define FLUTTER_WEBRTC_RTC_PEER_CONNECTION_HXX
 
 #include "flutter_common.h"
+#include "flutter_image_encoder.h"
 #include "flutter_webrtc_base.h"
 
 namespace flutter_webrtc_plugin {
@@ -38,6 +39,10 @@ class FlutterPeerConnectionObserver : public RTCPeerConnectionObserver {
 
   void RemoveStreamForId(const std::string& id);
 
+  const EventChannelProxy* event_channel() const {
+    return event_channel_.get();
+  }
+
  private:
   std::unique_ptr<EventChannelProxy> event_channel_;
   scoped_refptr<RTCPeerConnection> peerconnection_;
@@ -121,7 +126,7 @@ class FlutterPeerConnection {
                              std::unique_ptr<MethodResultProxy> result);
 
   scoped_refptr<RTCRtpParameters> updateRtpParameters(
-      EncodableMap newParameters,
+      const EncodableMap& newParameters,
       scoped_refptr<RTCRtpParameters> parameters);
 
   void RtpSenderSetParameters(RTCPeerConnection* pc,
@@ -144,6 +149,11 @@ class FlutterPeerConnection {
 
   void CaptureFrame(RTCVideoTrack* track,
                     std::string path,
+                    ImageFormat format,
+                    int quality,
+                    size_t max_width,
+                    size_t max_height,
+                    std::chrono::milliseconds timeout,
                     std::unique_ptr<MethodResultProxy> result);
 
   scoped_refptr<RTCRtpTransceiver> getRtpTransceiverById(RTCPeerConnection* pc,
@@ -157,7 +167,7 @@ class FlutterPeerConnection {
   void RtpTransceiverSetCodecPreferences(
       RTCPeerConnection* pc,
       std::string transceiverId,
-      const EncodableList codecs,
+      const EncodableList& codecs,
       std::unique_ptr<MethodResultProxy> result);
 
   void GetSenders(RTCPeerConnection* pc,
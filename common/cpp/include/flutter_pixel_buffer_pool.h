@@ -0,0 +1,59 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_PIXEL_BUFFER_POOL_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_PIXEL_BUFFER_POOL_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace flutter_webrtc_plugin {
+
+// Pixel buffers shared by all video renderers, so resolution changes reuse
+// memory instead of going back to the allocator every time.
+//
+// Sizes are rounded up to buckets at most 25% apart. A request may be served
+// by a free buffer up to twice its size, so a tile that flips between two
+// resolutions keeps reusing the larger buffer. Free buffers are only released
+// once they have been idle for a while or the pool holds too much.
+class PixelBufferPool : public std::enable_shared_from_this<PixelBufferPool> {
+ public:
+  ~PixelBufferPool();
+
+  struct Stats {
+    uint64_t allocations = 0;
+    uint64_t reuses = 0;
+    size_t bytes_in_use = 0;
+    size_t bytes_pooled = 0;
+  };
+
+  // Returns a buffer of at least |size| bytes that goes back to the pool once
+  // the last reference is dropped. The pool stays alive until then.
+  std::shared_ptr<uint8_t> Acquire(size_t size);
+
+  Stats stats() const;
+
+ private:
+  static constexpr size_t kMaxPooledBytes = 64 * 1024 * 1024;
+  static constexpr std::chrono::seconds kIdleTimeout{10};
+
+  struct FreeBuffer {
+    uint8_t* data;
+    std::chrono::steady_clock::time_point released;
+  };
+
+  static size_t BucketSize(size_t size);
+
+  void Release(uint8_t* data, size_t capacity);
+  // Frees idle buffers and, past kMaxPooledBytes, the least recently used.
+  void TrimLocked(std::chrono::steady_clock::time_point now);
+
+  mutable std::mutex mutex_;
+  std::multimap<size_t, FreeBuffer> free_;
+  Stats stats_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_PIXEL_BUFFER_POOL_H_
@@ -0,0 +1,52 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_CONVERSION_POOL_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_CONVERSION_POOL_H_
+
+#include "rtc_types.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+class FlutterVideoRenderer;
+
+// Worker threads shared by all video renderers that convert incoming frames
+// to pixel buffers off the decoder and raster threads.
+//
+// A renderer is queued at most once at a time and converts a single frame per
+// job, so busy renderers are served in turn instead of starving the others.
+class VideoConversionPool {
+ public:
+  explicit VideoConversionPool(size_t worker_count);
+  ~VideoConversionPool();
+
+  // Queues |renderer| to convert its pending frame.
+  void Schedule(scoped_refptr<FlutterVideoRenderer> renderer);
+
+  size_t worker_count() const { return workers_.size(); }
+
+  // Renderers currently waiting for a worker, and the highest that number has
+  // been since the pool was created.
+  size_t queue_depth() const;
+  size_t peak_queue_depth() const;
+
+ private:
+  void WorkerLoop();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<scoped_refptr<FlutterVideoRenderer>> queue_;
+  size_t peak_queue_depth_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_CONVERSION_POOL_H_
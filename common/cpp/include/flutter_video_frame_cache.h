@@ -0,0 +1,81 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CACHE_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CACHE_H_
+
+#include "flutter_pixel_buffer_pool.h"
+
+#include "rtc_video_frame.h"
+#include "rtc_video_track.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+// An RGBA frame ready to be handed to the engine. Shared between every
+// renderer that shows it.
+struct ConvertedFrame {
+  std::shared_ptr<uint8_t> data;
+  size_t width = 0;
+  size_t height = 0;
+};
+
+// Converts |frame| to RGBA at |width| x |height| into a buffer from |pool|.
+std::shared_ptr<const ConvertedFrame> ConvertVideoFrame(RTCVideoFrame* frame,
+                                                        size_t width,
+                                                        size_t height,
+                                                        PixelBufferPool* pool);
+
+// Recent conversions of one video track, so renderers showing the same track
+// at the same size convert each frame once between them.
+//
+// Every sink of a track receives its own RTCVideoFrame wrapper around the same
+// decoded buffer, so frames are identified by their Y plane. Each entry keeps
+// a reference to its frame, which keeps that pointer from being reused while
+// it is in the cache.
+class VideoConversionCache {
+ public:
+  // Returns |frame| converted to |width| x |height|. Converts it on a miss; if
+  // another renderer is already converting the same frame and size, waits for
+  // that result instead.
+  std::shared_ptr<const ConvertedFrame> GetOrConvert(
+      scoped_refptr<RTCVideoFrame> frame,
+      size_t width,
+      size_t height,
+      PixelBufferPool* pool);
+
+ private:
+  // Enough for two renderers of different sizes to be a frame apart.
+  static constexpr size_t kMaxEntries = 4;
+
+  struct Entry {
+    scoped_refptr<RTCVideoFrame> frame;
+    size_t width;
+    size_t height;
+    std::shared_future<std::shared_ptr<const ConvertedFrame>> result;
+  };
+
+  std::mutex mutex_;
+  std::deque<Entry> entries_;
+};
+
+// Hands out one VideoConversionCache per track, kept alive by the renderers
+// attached to it.
+class VideoConversionCacheRegistry {
+ public:
+  std::shared_ptr<VideoConversionCache> CacheForTrack(RTCVideoTrack* track);
+
+ private:
+  std::mutex mutex_;
+  std::map<RTCVideoTrack*, std::weak_ptr<VideoConversionCache>> caches_;
+};
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CACHE_H_
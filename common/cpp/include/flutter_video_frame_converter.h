@@ -0,0 +1,72 @@
+#ifndef FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CONVERTER_H_
+#define FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CONVERTER_H_
+
+#include "rtc_video_frame.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flutter_webrtc_plugin {
+
+using namespace libwebrtc;
+
+enum class YuvLayout {
+  kI420,  // Separate U and V planes.
+  kNV12,  // One plane of interleaved U/V pairs in |u|, |v| is unused.
+};
+
+// Read-only view of a 4:2:0 frame.
+struct YuvPlanes {
+  YuvLayout layout = YuvLayout::kI420;
+  const uint8_t* y = nullptr;
+  const uint8_t* u = nullptr;
+  const uint8_t* v = nullptr;
+  int stride_y = 0;
+  int stride_u = 0;
+  int stride_v = 0;
+  int width = 0;
+  int height = 0;
+};
+
+// Byte order of the 32-bit output pixels.
+enum class RgbFormat {
+  kRGBA,
+  kBGRA,
+};
+
+YuvPlanes YuvPlanesFromFrame(RTCVideoFrame* frame);
+
+// Returns the largest size with the aspect ratio of |src_width| x
+// |src_height| that fits in |box_width| x |box_height|. Frames are never
+// upscaled, and a zero box dimension leaves the source size unchanged.
+void FitFrameSize(size_t src_width,
+                  size_t src_height,
+                  size_t box_width,
+                  size_t box_height,
+                  size_t* out_width,
+                  size_t* out_height);
+
+// Converts |src| to 32-bit |format| pixels (BT.601 limited range), rotating it
+// clockwise by |rotation| degrees (0, 90, 180 or 270). |dst_width| x
+// |dst_height| is the size after rotation; when it differs from the source
+// the frame is bilinearly scaled in the same pass.
+void ConvertYuvToRgb(const YuvPlanes& src,
+                     RgbFormat format,
+                     int rotation,
+                     uint8_t* dst,
+                     int dst_stride,
+                     int dst_width,
+                     int dst_height);
+
+// Name of the row kernel picked for this CPU: "avx2", "sse4.1", "neon" or
+// "c".
+const char* YuvToRgbKernelName();
+
+// Makes later conversions use the kernel called |name|, for benchmarks.
+// Returns false, leaving the kernel unchanged, if it is unknown or this CPU
+// cannot run it.
+bool SetYuvToRgbKernel(const char* name);
+
+}  // namespace flutter_webrtc_plugin
+
+#endif  // FLUTTER_WEBRTC_PLUGIN_FLUTTER_VIDEO_FRAME_CONVERTER_H_
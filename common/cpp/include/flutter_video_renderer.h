@@ -2,11 +2,17 @@
 #define FLUTTER_WEBRTC_RTC_VIDEO_RENDERER_HXX
 
 #include "flutter_common.h"
+#include "flutter_latency_histogram.h"
+#include "flutter_video_conversion_pool.h"
+#include "flutter_video_frame_cache.h"
+#include "flutter_video_frame_converter.h"
 #include "flutter_webrtc_base.h"
 
 #include "rtc_video_frame.h"
 #include "rtc_video_renderer.h"
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 
 namespace flutter_webrtc_plugin {
@@ -24,17 +30,48 @@ class FlutterVideoRenderer
                   BinaryMessenger* messenger,
                   TaskRunner* task_runner,
                   std::unique_ptr<flutter::TextureVariant> texture,
-                  int64_t texture_id);
+                  int64_t texture_id,
+                  VideoConversionPool* conversion_pool,
+                  VideoConversionCacheRegistry* conversion_caches,
+                  PixelBufferPool* buffer_pool);
 
   virtual const FlutterDesktopPixelBuffer* CopyPixelBuffer(size_t width,
-                                                           size_t height) const;
+                                                           size_t height);
 
   virtual void OnFrame(scoped_refptr<RTCVideoFrame> frame) override;
 
+  // Called on a VideoConversionPool worker. Converts and publishes the newest
+  // frame received since the last call.
+  void ConvertPendingFrame();
+
+  // Drops the frame waiting to be converted, so that a CopyPixelBuffer still
+  // in flight on the raster thread schedules no further conversion.
+  void DropPendingFrame();
+
   void SetVideoTrack(scoped_refptr<RTCVideoTrack> track);
 
+  // By default frames are scaled down to the size the texture is drawn at.
+  // Full resolution keeps every frame at its source size.
+  void SetFullResolution(bool full_resolution) {
+    full_resolution_.store(full_resolution, std::memory_order_relaxed);
+  }
+
+  // Frames arriving faster than |max_frame_rate| are dropped before they are
+  // converted or announced to the engine. 0 renders every frame.
+  void SetMaxFrameRate(double max_frame_rate) {
+    max_frame_rate_.store(max_frame_rate, std::memory_order_relaxed);
+  }
+
+  // Per-texture counters and timings for videoRendererGetStats.
+  EncodableMap GetStats() const;
+
   int64_t texture_id() { return texture_id_; }
 
+  // Null until initialize().
+  const EventChannelProxy* event_channel() const {
+    return event_channel_.get();
+  }
+
   bool CheckMediaStream(std::string mediaId);
 
   bool CheckVideoTrack(std::string mediaId);
@@ -52,17 +89,81 @@ class FlutterVideoRenderer
   std::unique_ptr<EventChannelProxy> event_channel_;
   int64_t texture_id_ = -1;
   scoped_refptr<RTCVideoTrack> track_ = nullptr;
-  scoped_refptr<RTCVideoFrame> frame_;
   std::unique_ptr<flutter::TextureVariant> texture_;
-  std::shared_ptr<FlutterDesktopPixelBuffer> pixel_buffer_;
-  mutable std::shared_ptr<uint8_t[]> rgb_buffer_;
-  mutable std::mutex mutex_;
+  VideoConversionPool* conversion_pool_ = nullptr;
+  VideoConversionCacheRegistry* conversion_caches_ = nullptr;
+  PixelBufferPool* buffer_pool_ = nullptr;
+
+  void ConvertFrame(scoped_refptr<RTCVideoFrame> frame,
+                    std::chrono::steady_clock::time_point received,
+                    VideoConversionCache* cache);
+
+  // Newest frame not yet converted. |conversion_scheduled_| is set while the
+  // renderer sits in the pool's queue or is being converted, so it is never
+  // queued twice. |awaiting_consume_| is set from the moment a converted frame
+  // is announced to the engine until CopyPixelBuffer picks it up; meanwhile
+  // newer frames replace |pending_frame_| without being converted, and the
+  // engine is not notified again.
+  std::mutex pending_mutex_;
+  scoped_refptr<RTCVideoFrame> pending_frame_;
+  std::chrono::steady_clock::time_point pending_frame_received_;
+  std::shared_ptr<VideoConversionCache> conversion_cache_;
+  bool conversion_scheduled_ = false;
+  bool awaiting_consume_ = false;
+  std::atomic<uint64_t> frames_skipped_{0};
+
+  void OnFrameConsumed();
+
+  // A converted frame, possibly shared with other renderers of the same
+  // track, and the descriptor handed to the engine for it.
+  struct RenderBuffer {
+    std::shared_ptr<const ConvertedFrame> frame;
+    FlutterDesktopPixelBuffer pixels = {};
+    std::chrono::steady_clock::time_point received;
+  };
+
+  // Triple buffer between ConvertFrame (producer, one pool worker at a time)
+  // and CopyPixelBuffer (consumer, raster thread). The producer owns
+  // |write_index_|, the consumer owns |read_index_| and the third slot is
+  // handed over through |shared_state_|, which packs its index together with
+  // kFreshFrameBit when it holds a frame the consumer has not seen yet.
+  static constexpr uint32_t kSlotIndexMask = 0x3;
+  static constexpr uint32_t kFreshFrameBit = 0x4;
+  RenderBuffer buffers_[3];
+  uint32_t write_index_ = 0;
+  std::atomic<uint32_t> shared_state_{1};
+  uint32_t read_index_ = 2;
+
+  // Size the engine last asked for in CopyPixelBuffer; the next frames are
+  // converted to fit it.
+  std::atomic<size_t> target_width_{0};
+  std::atomic<size_t> target_height_{0};
+  std::atomic<bool> full_resolution_{false};
+
+  // Frame-rate cap. |next_frame_time_| is only touched by OnFrame.
+  std::atomic<double> max_frame_rate_{0};
+  std::chrono::steady_clock::time_point next_frame_time_;
+
+  bool ShouldDropFrame();
+
+  // Frames received in OnFrame, converted by the pool, and picked up by the
+  // engine. Received frames that were never converted were either dropped by
+  // the frame-rate cap or skipped because a newer one replaced them.
+  std::atomic<uint64_t> frames_received_{0};
+  std::atomic<uint64_t> frames_dropped_{0};
+  std::atomic<uint64_t> frames_converted_{0};
+  std::atomic<uint64_t> frames_rendered_{0};
+  LatencyHistogram conversion_time_;
+  // From OnFrame until CopyPixelBuffer hands the frame to the engine.
+  LatencyHistogram frame_age_;
+
   RTCVideoFrame::VideoRotation rotation_ = RTCVideoFrame::kVideoRotation_0;
 };
 
 class FlutterVideoRendererManager {
  public:
   FlutterVideoRendererManager(FlutterWebRTCBase* base);
+  ~FlutterVideoRendererManager();
 
   void CreateVideoRendererTexture(std::unique_ptr<MethodResultProxy> result);
 
@@ -71,12 +172,24 @@ class FlutterVideoRendererManager {
                                  const std::string& owner_tag,
                                  const std::string& track_id);
 
+  void VideoRendererSetOptions(int64_t texture_id,
+                               const EncodableMap& options,
+                               std::unique_ptr<MethodResultProxy> result);
+
   void VideoRendererDispose(int64_t texture_id,
                             std::unique_ptr<MethodResultProxy> result);
 
+  void VideoRendererGetStats(const EncodableMap& params,
+                             std::unique_ptr<MethodResultProxy> result);
+
  private:
   FlutterWebRTCBase* base_;
+  VideoConversionCacheRegistry conversion_caches_;
+  std::shared_ptr<PixelBufferPool> buffer_pool_;
   std::map<int64_t, scoped_refptr<FlutterVideoRenderer>> renderers_;
+  // Reset explicitly by the destructor, once no renderer can schedule
+  // another conversion.
+  std::unique_ptr<VideoConversionPool> conversion_pool_;
 };
 
 }  // namespace flutter_webrtc_plugin
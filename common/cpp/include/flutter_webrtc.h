@@ -6,7 +6,11 @@
 #include "flutter_data_channel.h"
 #include "flutter_data_packet_cryptor.h"
 #include "flutter_frame_cryptor.h"
+#include "flutter_frame_dump.h"
+#include "flutter_frame_tap.h"
+#include "flutter_media_recorder.h"
 #include "flutter_media_stream.h"
+#include "flutter_method_dispatcher.h"
 #include "flutter_peerconnection.h"
 #include "flutter_screen_capture.h"
 #include "flutter_video_renderer.h"
@@ -34,7 +38,11 @@ class FlutterWebRTC : public FlutterWebRTCBase,
                       public FlutterScreenCapture,
                       public FlutterDataChannel,
                       public FlutterFrameCryptor,
-                      public FlutterDataPacketCryptor {
+                      public FlutterDataPacketCryptor,
+                      public FlutterFrameTapManager,
+                      public FlutterMediaRecorderManager,
+                      public FlutterFrameDumpManager,
+                      public FlutterMethodDispatcher {
  public:
   FlutterWebRTC(FlutterWebRTCPlugin* plugin);
   virtual ~FlutterWebRTC();
@@ -43,6 +51,10 @@ class FlutterWebRTC : public FlutterWebRTCBase,
                         std::unique_ptr<MethodResultProxy> result);
 
  private:
+  void RegisterMethods();
+  // Buffered and dropped event counts of every event channel, for
+  // getEventChannelStats.
+  EncodableMap EventChannelStats();
   void initLoggerCallback(RTCLoggingSeverity severity);
   RTCLoggingSeverity str2LogSeverity(std::string str);
 };
@@ -28,6 +28,7 @@ namespace flutter_webrtc_plugin {
 using namespace libwebrtc;
 
 class FlutterVideoRenderer;
+class FrameCaptureWorker;
 class FlutterRTCDataChannelObserver;
 class FlutterPeerConnectionObserver;
 
@@ -41,6 +42,9 @@ class FlutterWebRTCBase {
   friend class FlutterScreenCapture;
   friend class FlutterFrameCryptor;
   friend class FlutterDataPacketCryptor;
+  friend class FlutterFrameTapManager;
+  friend class FlutterMediaRecorderManager;
+  friend class FlutterFrameDumpManager;
   enum ParseConstraintType { kMandatory, kOptional };
 
  public:
@@ -89,6 +93,9 @@ class FlutterWebRTCBase {
 
   EventChannelProxy* event_channel();
 
+  // Started on first use and joined when the plugin is destroyed.
+  FrameCaptureWorker* frame_capture_worker();
+
   libwebrtc::scoped_refptr<libwebrtc::RTCRtpSender> GetRtpSenderById(
       RTCPeerConnection* pc,
       std::string id);
@@ -136,6 +143,7 @@ class FlutterWebRTCBase {
   TaskRunner* task_runner_;
   TextureRegistrar* textures_;
   std::unique_ptr<EventChannelProxy> event_channel_;
+  std::unique_ptr<FrameCaptureWorker> frame_capture_worker_;
 };
 
 }  // namespace flutter_webrtc_plugin
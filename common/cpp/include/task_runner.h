@@ -8,9 +8,28 @@
  
  using TaskClosure = std::function<void()>;
  
+ // Lanes of a TaskRunner, highest priority first. Tasks run in order within
+ // a lane. Each pass of the platform thread's loop runs every lane up to its
+ // budget, in this order, so a burst in one lane delays the others by at most
+ // one pass and no lane starves.
+ enum class TaskPriority {
+   // Method call results and peer connection events.
+   kControl,
+   // Renderer, track and media device events.
+   kMediaEvents,
+   // Data channel messages and other high-volume traffic.
+   kBulkData,
+ };
+ 
+ constexpr int kTaskPriorityCount = 3;
+ 
+ // Tasks per lane per pass, indexed by TaskPriority.
+ constexpr int kTaskPriorityBudgets[kTaskPriorityCount] = {64, 32, 16};
+ 
  class TaskRunner {
   public:
-   virtual void EnqueueTask(TaskClosure task) = 0;
+   virtual void EnqueueTask(TaskClosure task,
+                            TaskPriority priority = TaskPriority::kControl) = 0;
    virtual ~TaskRunner() = default;
  };
  
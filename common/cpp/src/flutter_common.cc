@@ -1,7 +1,10 @@
 #include "flutter_common.h"
 #include "task_runner.h"
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 
 class MethodCallProxyImpl : public MethodCallProxy {
  public:
@@ -112,33 +115,128 @@ std::unique_ptr<MethodResultProxy> MethodResultProxy::Create(
                                                  task_runner);
 }
 
+namespace {
+
+// Bounded lock-free multi-producer multi-consumer ring (Vyukov). Besides the
+// flush on the platform thread, producers pop from it to make room when the
+// policy is to drop the oldest event.
+class EventRing {
+ public:
+  // |capacity| must be a power of two.
+  explicit EventRing(size_t capacity)
+      : cells_(new Cell[capacity]), mask_(capacity - 1) {
+    for (size_t i = 0; i < capacity; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false if the ring is full.
+  bool Push(const EncodableValue& event) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & mask_];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.event = event;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Number of events in the ring; approximate while others push or pop.
+  size_t ApproximateSize() const {
+    size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+    size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  // Returns false if the ring is empty, or its oldest event is still being
+  // written.
+  bool Pop(EncodableValue* event) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & mask_];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          *event = std::move(cell.event);
+          cell.event = EncodableValue();
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    EncodableValue event;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  const size_t mask_;
+  std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dequeue_pos_{0};
+};
+
+// The key events coalesce by: the "event" name of map events.
+const std::string* CoalesceKey(const EncodableValue& event) {
+  if (!TypeIs<EncodableMap>(event)) {
+    return nullptr;
+  }
+  const EncodableValue& key =
+      findEncodableValue(GetValue<EncodableMap>(event), "event");
+  return TypeIs<std::string>(key) ? &GetValue<std::string>(key) : nullptr;
+}
+
+}  // namespace
+
 class EventChannelProxyImpl : public EventChannelProxy {
   public:
    EventChannelProxyImpl(BinaryMessenger* messenger,
                          TaskRunner* task_runner,
-                         const std::string& channelName)
+                         const std::string& channelName,
+                         TaskPriority priority,
+                         EventDropPolicy drop_policy)
        : channel_(std::make_unique<EventChannel>(
              messenger,
              channelName,
              &flutter::StandardMethodCodec::GetInstance())),
-             task_runner_(task_runner) {
+             task_runner_(task_runner),
+             priority_(priority),
+             pending_(std::make_shared<PendingEvents>(drop_policy)) {
      auto handler = std::make_unique<
          flutter::StreamHandlerFunctions<EncodableValue>>(
          [&](const EncodableValue* arguments,
              std::unique_ptr<flutter::EventSink<EncodableValue>>&& events)
              -> std::unique_ptr<flutter::StreamHandlerError<EncodableValue>> {
-           sink_ = std::move(events);
-           std::weak_ptr<EventSink> weak_sink = sink_;
-           for (auto& event : event_queue_) {
-            PostEvent(event);
-           }
-           event_queue_.clear();
-           on_listen_called_ = true;
+           std::atomic_store(&sink_,
+                             std::shared_ptr<EventSink>(std::move(events)));
+           batch_events_ = arguments && TypeIs<EncodableMap>(*arguments) &&
+                           findBoolean(GetValue<EncodableMap>(*arguments),
+                                       "batchEvents");
+           SchedulePending(true);
            return nullptr;
          },
          [&](const EncodableValue* arguments)
              -> std::unique_ptr<flutter::StreamHandlerError<EncodableValue>> {
-           on_listen_called_ = false;
+           pending_->listening.store(false);
            return nullptr;
          });
  
@@ -147,41 +245,249 @@ class EventChannelProxyImpl : public EventChannelProxy {
 
    virtual ~EventChannelProxyImpl() { channel_->SetStreamHandler(nullptr); }
 
-   void Success(const EncodableValue& event, bool cache_event = true) override {
-     if (on_listen_called_) {
-       PostEvent(event);
-     } else {
-       if (cache_event) {
-         event_queue_.push_back(event);
-       }
+   void Success(EncodableValue event, bool cache_event = true) override {
+     if (pending_->listening.load()) {
+       PostEvent(std::move(event));
+       return;
+     }
+     if (!cache_event) {
+       return;
+     }
+     Buffer(event, false);
+   }
+
+   void SuccessState(EncodableValue event) override {
+     if (pending_->listening.load()) {
+       PostEvent(std::move(event));
+       return;
+     }
+     Buffer(event, true);
+   }
+
+   void Buffer(const EncodableValue& event, bool state) {
+     pending_->Push(event, state);
+     // A flush that started listening meanwhile may have drained the buffer
+     // before this event landed. Drain it again behind that flush.
+     std::atomic_thread_fence(std::memory_order_seq_cst);
+     if (pending_->listening.load()) {
+       SchedulePending(false);
      }
    }
 
-   void PostEvent(const EncodableValue& event) {
+   uint64_t queued_events() const override {
+     return pending_->queued.load(std::memory_order_relaxed);
+   }
+
+   uint64_t dropped_events() const override {
+     return pending_->dropped.load(std::memory_order_relaxed);
+   }
+
+   // Sends the buffered events on the platform thread, in the channel's lane
+   // so that they precede any event posted after this. |start_listening| is
+   // set for the flush when the listener attaches.
+   void SchedulePending(bool start_listening) {
+     std::shared_ptr<EventSink> sink = this->sink();
+     std::weak_ptr<EventSink> weak_sink = sink;
+     std::shared_ptr<PendingEvents> pending = pending_;
+     bool batch = batch_events_;
+     if (!task_runner_) {
+       pending->Flush(sink, batch, start_listening);
+       return;
+     }
+     task_runner_->EnqueueTask(
+         [weak_sink, pending, batch, start_listening]() {
+           pending->Flush(weak_sink.lock(), batch, start_listening);
+         },
+         priority_);
+   }
+
+   void PostEvent(EncodableValue event) {
+     if (task_runner_ && batch_events_) {
+       PostBatchedEvent(std::move(event));
+       return;
+     }
      if(task_runner_) {
-      std::weak_ptr<EventSink> weak_sink = sink_;
-       task_runner_->EnqueueTask([weak_sink, event]() {
+      std::weak_ptr<EventSink> weak_sink = sink();
+       task_runner_->EnqueueTask([weak_sink, event = std::move(event)]() {
         auto sink = weak_sink.lock();
         if (sink) {
           sink->Success(event);
         }
-      });
+      }, priority_);
      } else {
-      sink_->Success(event);
+      sink()->Success(event);
      }
    }
  
+   // Events posted before the platform thread gets to send them go out
+   // together as one EncodableList, so a burst costs one platform message.
+   void PostBatchedEvent(EncodableValue event) {
+     {
+       std::lock_guard<std::mutex> lock(batch_->mutex);
+       batch_->events.push_back(std::move(event));
+       if (batch_->events.size() > 1) {
+         // Already scheduled to be sent.
+         return;
+       }
+     }
+     std::weak_ptr<EventSink> weak_sink = sink();
+     std::shared_ptr<EventBatch> batch = batch_;
+     task_runner_->EnqueueTask(
+         [weak_sink, batch]() {
+           EncodableList events;
+           {
+             std::lock_guard<std::mutex> lock(batch->mutex);
+             events.swap(batch->events);
+           }
+           auto sink = weak_sink.lock();
+           if (sink) {
+             sink->Success(EncodableValue(std::move(events)));
+           }
+         },
+         priority_);
+   }
+
   private:
+   // |sink_| is replaced on the platform thread when the listener attaches
+   // again, while libwebrtc threads post events, so it is only accessed
+   // atomically.
+   std::shared_ptr<EventSink> sink() const { return std::atomic_load(&sink_); }
+
+   struct EventBatch {
+     std::mutex mutex;
+     EncodableList events;
+   };
+
+   // Events that arrive while no one listens, bounded at kCapacity. Shared
+   // with the flush task, which may outlive the proxy.
+   struct PendingEvents {
+     static constexpr size_t kCapacity = 256;
+     // Slots only state events may take under kDropNewest.
+     static constexpr size_t kStateReserve = 16;
+
+     explicit PendingEvents(EventDropPolicy drop_policy)
+         : drop_policy(drop_policy), ring(kCapacity) {}
+
+     void Push(const EncodableValue& event, bool state) {
+       if (drop_policy == EventDropPolicy::kCoalesce) {
+         PushCoalesced(event);
+         return;
+       }
+       bool drop_newest = drop_policy == EventDropPolicy::kDropNewest && !state;
+       if (drop_newest && ring.ApproximateSize() >= kCapacity - kStateReserve) {
+         dropped.fetch_add(1, std::memory_order_relaxed);
+         return;
+       }
+       // A state event that finds even the reserve full pushes out the
+       // oldest event instead.
+       while (!ring.Push(event)) {
+         if (drop_newest) {
+           dropped.fetch_add(1, std::memory_order_relaxed);
+           return;
+         }
+         EncodableValue oldest;
+         if (ring.Pop(&oldest)) {
+           dropped.fetch_add(1, std::memory_order_relaxed);
+         }
+       }
+       queued.fetch_add(1, std::memory_order_relaxed);
+     }
+
+     // Replaces the buffered event with the same key, so that a burst of one
+     // kind of event cannot push the others out. The replacement goes to the
+     // back, so buffered events keep the order of their latest occurrence.
+     void PushCoalesced(const EncodableValue& event) {
+       std::lock_guard<std::mutex> lock(coalesced_mutex);
+       const std::string* key = CoalesceKey(event);
+       if (key) {
+         for (auto it = coalesced.begin(); it != coalesced.end(); ++it) {
+           const std::string* buffered_key = CoalesceKey(*it);
+           if (buffered_key && *buffered_key == *key) {
+             coalesced.erase(it);
+             dropped.fetch_add(1, std::memory_order_relaxed);
+             break;
+           }
+         }
+       }
+       if (coalesced.size() == kCapacity) {
+         coalesced.pop_front();
+         dropped.fetch_add(1, std::memory_order_relaxed);
+       }
+       coalesced.push_back(event);
+       queued.fetch_add(1, std::memory_order_relaxed);
+     }
+
+     // Platform thread. Sends what was buffered, in order. With
+     // |start_listening| it first starts listening, so that the buffer
+     // precedes every event posted from now on; producers that push while it
+     // drains see that and schedule another flush.
+     void Flush(std::shared_ptr<EventSink> sink,
+                bool batch,
+                bool start_listening) {
+       if (start_listening) {
+         listening.store(true);
+       } else if (!listening.load()) {
+         // Cancelled since; keep the events for the next listener.
+         return;
+       }
+       std::atomic_thread_fence(std::memory_order_seq_cst);
+       EncodableList events;
+       if (drop_policy == EventDropPolicy::kCoalesce) {
+         std::lock_guard<std::mutex> lock(coalesced_mutex);
+         events.assign(std::make_move_iterator(coalesced.begin()),
+                       std::make_move_iterator(coalesced.end()));
+         coalesced.clear();
+       } else {
+         EncodableValue event;
+         while (ring.Pop(&event)) {
+           events.push_back(std::move(event));
+         }
+       }
+       if (events.empty()) {
+         return;
+       }
+       if (!sink) {
+         // The channel went away before the flush ran.
+         dropped.fetch_add(events.size(), std::memory_order_relaxed);
+         return;
+       }
+       if (batch) {
+         sink->Success(EncodableValue(std::move(events)));
+         return;
+       }
+       for (const EncodableValue& buffered : events) {
+         sink->Success(buffered);
+       }
+     }
+
+     const EventDropPolicy drop_policy;
+     // Used by the drop policies.
+     EventRing ring;
+     // Used instead of |ring| to coalesce, which has to find the buffered
+     // event with the same key.
+     std::mutex coalesced_mutex;
+     std::deque<EncodableValue> coalesced;
+     std::atomic<bool> listening{false};
+     std::atomic<uint64_t> queued{0};
+     std::atomic<uint64_t> dropped{0};
+   };
+
    std::unique_ptr<EventChannel> channel_;
    std::shared_ptr<flutter::EventSink<flutter::EncodableValue>> sink_;
-   std::list<EncodableValue> event_queue_;
-   bool on_listen_called_ = false;
    TaskRunner* task_runner_;
+   TaskPriority priority_;
+   std::shared_ptr<PendingEvents> pending_;
+   // Set when the listener asks for {"batchEvents": true}.
+   std::atomic<bool> batch_events_{false};
+   std::shared_ptr<EventBatch> batch_ = std::make_shared<EventBatch>();
  };
 
 std::unique_ptr<EventChannelProxy> EventChannelProxy::Create(
     BinaryMessenger* messenger,
     TaskRunner* task_runner,
-    const std::string& channelName) {
-  return std::make_unique<EventChannelProxyImpl>(messenger, task_runner, channelName);
+    const std::string& channelName,
+    TaskPriority priority,
+    EventDropPolicy drop_policy) {
+  return std::make_unique<EventChannelProxyImpl>(
+      messenger, task_runner, channelName, priority, drop_policy);
 }
\ No newline at end of file
@@ -2,14 +2,27 @@
 
 #include <vector>
 
+#include "flutter_event_builder.h"
+
 namespace flutter_webrtc_plugin {
 
+namespace {
+
+const EventTemplate kStateChangedEvent("dataChannelStateChanged");
+const EventTemplate kReceiveMessageEvent("dataChannelReceiveMessage");
+
+}  // namespace
+
 FlutterRTCDataChannelObserver::FlutterRTCDataChannelObserver(
     scoped_refptr<RTCDataChannel> data_channel,
     BinaryMessenger* messenger,
     TaskRunner* task_runner,
     const std::string& channelName)
-    : event_channel_(EventChannelProxy::Create(messenger, task_runner, channelName)),
+    : event_channel_(EventChannelProxy::Create(messenger,
+                                               task_runner,
+                                               channelName,
+                                               TaskPriority::kBulkData,
+                                               EventDropPolicy::kDropNewest)),
       data_channel_(data_channel) {
   data_channel_->RegisterObserver(this);
 }
@@ -76,11 +89,11 @@ void FlutterDataChannel::DataChannelSend(
     std::unique_ptr<MethodResultProxy> result) {
   bool is_binary = type == "binary";
   if (is_binary && TypeIs<std::vector<uint8_t>>(data)) {
-    std::vector<uint8_t> buffer = GetValue<std::vector<uint8_t>>(data);
+    const std::vector<uint8_t>& buffer = GetValue<std::vector<uint8_t>>(data);
     data_channel->Send(buffer.data(), static_cast<uint32_t>(buffer.size()),
                        true);
   } else {
-    std::string str = GetValue<std::string>(data);
+    const std::string& str = GetValue<std::string>(data);
     data_channel->Send(reinterpret_cast<const uint8_t*>(str.c_str()),
                        static_cast<uint32_t>(str.length()), false);
   }
@@ -131,28 +144,23 @@ static const char* DataStateString(RTCDataChannelState state) {
 }
 
 void FlutterRTCDataChannelObserver::OnStateChange(RTCDataChannelState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = EncodableValue("dataChannelStateChanged");
-  params[EncodableValue("id")] = EncodableValue(data_channel_->id());
-  params[EncodableValue("state")] = EncodableValue(DataStateString(state));
-  auto data = EncodableValue(params);
-  event_channel_->Success(data);
+  event_channel_->SuccessState(kStateChangedEvent.New()
+                                   .Set(keys::kId, data_channel_->id())
+                                   .Set(keys::kState, DataStateString(state))
+                                   .Build());
 }
 
 void FlutterRTCDataChannelObserver::OnMessage(const char* buffer,
                                               int length,
                                               bool binary) {
-  EncodableMap params;
-  params[EncodableValue("event")] = EncodableValue("dataChannelReceiveMessage");
-
-  params[EncodableValue("id")] = EncodableValue(data_channel_->id());
-  params[EncodableValue("type")] = EncodableValue(binary ? "binary" : "text");
-  std::string str(buffer, length);
-  params[EncodableValue("data")] =
-      binary ? EncodableValue(std::vector<uint8_t>(str.begin(), str.end()))
-             : EncodableValue(str);
-
-  auto data = EncodableValue(params);
-  event_channel_->Success(data);
+  EventBuilder event = kReceiveMessageEvent.New();
+  event.Set(keys::kId, data_channel_->id())
+      .Set(keys::kType, binary ? "binary" : "text");
+  if (binary) {
+    event.Set(keys::kData, std::vector<uint8_t>(buffer, buffer + length));
+  } else {
+    event.Set(keys::kData, std::string(buffer, length));
+  }
+  event_channel_->Success(event.Build());
 }
 }  // namespace flutter_webrtc_plugin
@@ -5,31 +5,29 @@
 
 namespace flutter_webrtc_plugin {
 
-bool FlutterDataPacketCryptor::HandleDataPacketCryptorMethodCall(
-    const MethodCallProxy& method_call,
-    std::unique_ptr<MethodResultProxy> result,
-    std::unique_ptr<MethodResultProxy>* outResult) {
-  const std::string& method_name = method_call.method_name();
-  if (!method_call.arguments()) {
-    result->Error("Bad Arguments", "Null arguments received");
-    return true;
-  }
-  const EncodableMap params = GetValue<EncodableMap>(*method_call.arguments());
-  if (method_name == "createDataPacketCryptor") {
-    CreateDataPacketCryptor(params, std::move(result));
-    return true;
-  } else if (method_name == "dataPacketCryptorDispose") {
-    DataPacketCryptorDispose(params, std::move(result));
-    return true;
-  } else if (method_name == "dataPacketCryptorEncrypt") {
-    DataPacketCryptorEncrypt(params, std::move(result));
-    return true;
-  } else if (method_name == "dataPacketCryptorDecrypt") {
-    DataPacketCryptorDecrypt(params, std::move(result));
-    return true;
-  }
-  *outResult = std::move(result);
-  return false;
+void FlutterDataPacketCryptor::RegisterDataPacketCryptorMethods(
+    FlutterMethodDispatcher* dispatcher) {
+  using Handler = void (FlutterDataPacketCryptor::*)(
+      const EncodableMap&, std::unique_ptr<MethodResultProxy>);
+  static const std::pair<const char*, Handler> kMethods[] = {
+      {"createDataPacketCryptor",
+       &FlutterDataPacketCryptor::CreateDataPacketCryptor},
+      {"dataPacketCryptorDispose",
+       &FlutterDataPacketCryptor::DataPacketCryptorDispose},
+      {"dataPacketCryptorEncrypt",
+       &FlutterDataPacketCryptor::DataPacketCryptorEncrypt},
+      {"dataPacketCryptorDecrypt",
+       &FlutterDataPacketCryptor::DataPacketCryptorDecrypt},
+  };
+  for (const auto& method : kMethods) {
+    Handler handler = method.second;
+    dispatcher->RegisterWithParams(
+        method.first,
+        [this, handler](const EncodableMap& params,
+                        std::unique_ptr<MethodResultProxy> result) {
+          (this->*handler)(params, std::move(result));
+        });
+  }
 }
 
 
@@ -112,7 +110,7 @@ void FlutterDataPacketCryptor::DataPacketCryptorEncrypt(
                   "dataPacketCryptorEncrypt() keyIndex is null");
     return;
   }
-  auto data = findVector(constraints, "data");
+  const auto& data = findVector(constraints, "data");
   if (data.size() == 0) {
     result->Error("dataPacketCryptorEncrypt",
                   "dataPacketCryptorEncrypt() data is null or empty");
@@ -164,13 +162,13 @@ void FlutterDataPacketCryptor::DataPacketCryptorDecrypt(
                   "dataPacketCryptorDecrypt() keyIndex is null");
     return;
   }
-  auto encryptedData = findVector(constraints, "data");
+  const auto& encryptedData = findVector(constraints, "data");
   if (encryptedData.size() == 0) {
     result->Error("dataPacketCryptorDecrypt",
                   "dataPacketCryptorDecrypt() encrypted data is null or empty");
     return;
   }
-  auto iv = findVector(constraints, "iv");
+  const auto& iv = findVector(constraints, "iv");
   if (iv.size() == 0) {
     result->Error("dataPacketCryptorDecrypt",
                   "dataPacketCryptorDecrypt() iv is null or empty");
@@ -3,74 +3,198 @@
 #endif
 
 #include "flutter_frame_capturer.h"
+#include "flutter_video_frame_converter.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include "svpng.hpp"
+#include <algorithm>
 
 namespace flutter_webrtc_plugin {
 
-FlutterFrameCapturer::FlutterFrameCapturer(RTCVideoTrack* track,
-                                           std::string path) {
-  track_ = track;
-  path_ = path;
+FrameCaptureWorker::FrameCaptureWorker()
+    : thread_(&FrameCaptureWorker::Run, this) {}
+
+FrameCaptureWorker::~FrameCaptureWorker() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
 }
 
-void FlutterFrameCapturer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
-  if (frame_ != nullptr) {
+void FrameCaptureWorker::Add(std::shared_ptr<FlutterFrameCapturer> capturer,
+                             std::shared_ptr<MethodResultProxy> result,
+                             std::chrono::milliseconds timeout) {
+  bool added = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stopping_) {
+      captures_.push_back(
+          {capturer, result, std::chrono::steady_clock::now() + timeout});
+      woken_ = true;
+      added = true;
+    }
+  }
+  if (!added) {
+    capturer->Cancel(result);
     return;
   }
+  cv_.notify_one();
+}
 
-  frame_ = frame.get()->Copy();
-  catch_frame_ = true;
+void FrameCaptureWorker::Wake() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    woken_ = true;
+  }
+  cv_.notify_one();
 }
 
-void FlutterFrameCapturer::CaptureFrame(
-    std::unique_ptr<MethodResultProxy> result) {
-  mutex_.lock();
-  // Here init catch_frame_ flag
-  catch_frame_ = false;
+void FrameCaptureWorker::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    woken_ = false;
+    auto now = std::chrono::steady_clock::now();
+    auto next_deadline = std::chrono::steady_clock::time_point::max();
+    auto ready = captures_.end();
+    for (auto it = captures_.begin(); it != captures_.end(); ++it) {
+      if (it->deadline <= now || it->capturer->HasFrame()) {
+        ready = it;
+        break;
+      }
+      next_deadline = std::min(next_deadline, it->deadline);
+    }
+    if (ready == captures_.end()) {
+      cv_.wait_until(lock, next_deadline,
+                     [this] { return stopping_ || woken_; });
+      continue;
+    }
+
+    Capture capture = std::move(*ready);
+    captures_.erase(ready);
+    lock.unlock();
+    capture.capturer->Finish(capture.result);
+    // Drop the references outside the lock in case they are the last ones.
+    capture = Capture();
+    lock.lock();
+  }
+
+  std::list<Capture> cancelled;
+  cancelled.swap(captures_);
+  lock.unlock();
+  for (auto& capture : cancelled) {
+    capture.capturer->Cancel(capture.result);
+  }
+}
+
+FlutterFrameCapturer::FlutterFrameCapturer(scoped_refptr<RTCVideoTrack> track,
+                                           std::string path,
+                                           ImageFormat format,
+                                           int quality,
+                                           size_t max_width,
+                                           size_t max_height,
+                                           FrameCaptureWorker* worker)
+    : track_(track),
+      path_(path),
+      format_(format),
+      quality_(quality),
+      max_width_(max_width),
+      max_height_(max_height),
+      worker_(worker) {}
 
+void FlutterFrameCapturer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_ != nullptr) {
+      return;
+    }
+    frame_ = frame.get()->Copy();
+  }
+  worker_->Wake();
+}
+
+void FlutterFrameCapturer::CaptureFrame(
+    std::unique_ptr<MethodResultProxy> result,
+    std::chrono::milliseconds timeout) {
+  std::shared_ptr<MethodResultProxy> result_ptr(result.release());
   track_->AddRenderer(this);
-  // Here waiting for catch_frame_ is set to true
-  while(!catch_frame_){}
-  // Here unlock the mutex
-  mutex_.unlock();
+  worker_->Add(shared_from_this(), result_ptr, timeout);
+}
+
+bool FlutterFrameCapturer::HasFrame() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return frame_ != nullptr;
+}
 
-  mutex_.lock();
+void FlutterFrameCapturer::Finish(std::shared_ptr<MethodResultProxy> result) {
+  scoped_refptr<RTCVideoFrame> frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame = frame_;
+  }
+  // Detaching from here rather than from OnFrame, which runs under the
+  // track's sink lock that RemoveRenderer takes as well.
   track_->RemoveRenderer(this);
 
-  bool success = SaveFrame();
-  mutex_.unlock();
+  if (frame == nullptr) {
+    result->Error("captureFrame",
+                  "captureFrame() timed out waiting for a frame");
+    return;
+  }
 
-  std::shared_ptr<MethodResultProxy> result_ptr(result.release());
-  if (success) {
-    result_ptr->Success();
+  std::vector<uint8_t> image = EncodeFrame(frame);
+  if (path_.empty()) {
+    EncodableValue bytes;
+    bytes = std::move(image);
+    result->Success(bytes);
+    return;
+  }
+
+  if (WriteToFile(image)) {
+    result->Success();
   } else {
-    result_ptr->Error("1", "Cannot save the frame as .png file");
+    result->Error("1", "Cannot save the frame to file");
   }
 }
 
-bool FlutterFrameCapturer::SaveFrame() {
-  if (frame_ == nullptr) {
-    return false;
-  }
+void FlutterFrameCapturer::Cancel(std::shared_ptr<MethodResultProxy> result) {
+  track_->RemoveRenderer(this);
+  result->Error("captureFrame", "captureFrame() was cancelled");
+}
 
-  int width = frame_.get()->width();
-  int height = frame_.get()->height();
+std::vector<uint8_t> FlutterFrameCapturer::EncodeFrame(
+    scoped_refptr<RTCVideoFrame> frame) {
+  // Encode the frame upright, the way it is displayed.
+  int rotation = static_cast<int>(frame->rotation());
+  bool transpose = rotation == 90 || rotation == 270;
+  size_t upright_width = transpose ? frame->height() : frame->width();
+  size_t upright_height = transpose ? frame->width() : frame->height();
+  size_t width = 0;
+  size_t height = 0;
+  FitFrameSize(upright_width, upright_height,
+               max_width_ ? max_width_ : upright_width,
+               max_height_ ? max_height_ : upright_height, &width, &height);
   int bytes_per_pixel = 4;
-  uint8_t* pixels = new uint8_t[width * height * bytes_per_pixel];
+  std::unique_ptr<uint8_t[]> pixels(
+      new uint8_t[width * height * bytes_per_pixel]);
+
+  ConvertYuvToRgb(YuvPlanesFromFrame(frame.get()), RgbFormat::kRGBA, rotation,
+                  pixels.get(), static_cast<int>(width) * bytes_per_pixel,
+                  static_cast<int>(width), static_cast<int>(height));
 
-  frame_.get()->ConvertToARGB(RTCVideoFrame::Type::kABGR, pixels,
-                              /* unused */ -1, width, height);
+  return EncodeImage(pixels.get(), static_cast<int>(width),
+                     static_cast<int>(height),
+                     static_cast<int>(width) * bytes_per_pixel, format_,
+                     quality_);
+}
 
+bool FlutterFrameCapturer::WriteToFile(const std::vector<uint8_t>& image) {
   FILE* file = fopen(path_.c_str(), "wb");
   if (!file) {
     return false;
   }
-
-  svpng(file, width, height, pixels, 1);
-  fclose(file);
-  return true;
+  bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+  return fclose(file) == 0 && written;
 }
 
 }  // namespace flutter_webrtc_plugin
\ No newline at end of file
@@ -1,9 +1,17 @@
 #include "flutter_frame_cryptor.h"
 
 #include "base/scoped_ref_ptr.h"
+#include "flutter_event_builder.h"
 
 namespace flutter_webrtc_plugin {
 
+namespace {
+
+const EventTemplate kFrameCryptionStateChangedEvent(
+    "frameCryptionStateChanged");
+
+}  // namespace
+
 libwebrtc::KeyDerivationAlgorithm KeyDerivationAlgorithmFromInt(int algorithm) {
   switch (algorithm) {
     case 0:
@@ -49,75 +57,51 @@ std::string frameCryptionStateToString(libwebrtc::RTCFrameCryptionState state) {
 void FlutterFrameCryptorObserver::OnFrameCryptionStateChanged(
     const string participant_id,
     libwebrtc::RTCFrameCryptionState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = EncodableValue("frameCryptionStateChanged");
-  params[EncodableValue("participantId")] =
-      EncodableValue(participant_id.std_string());
-  params[EncodableValue("state")] =
-      EncodableValue(frameCryptionStateToString(state));
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(
+      kFrameCryptionStateChangedEvent.New()
+          .Set(keys::kParticipantId, participant_id.std_string())
+          .Set(keys::kState, frameCryptionStateToString(state))
+          .Build());
 }
 
-bool FlutterFrameCryptor::HandleFrameCryptorMethodCall(
-    const MethodCallProxy& method_call,
-    std::unique_ptr<MethodResultProxy> result,
-    std::unique_ptr<MethodResultProxy>* outResult) {
-  const std::string& method_name = method_call.method_name();
-  if (!method_call.arguments()) {
-    result->Error("Bad Arguments", "Null arguments received");
-    return true;
-  }
-  const EncodableMap params = GetValue<EncodableMap>(*method_call.arguments());
-
-  if (method_name == "frameCryptorFactoryCreateFrameCryptor") {
-    FrameCryptorFactoryCreateFrameCryptor(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorSetKeyIndex") {
-    FrameCryptorSetKeyIndex(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorGetKeyIndex") {
-    FrameCryptorGetKeyIndex(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorSetEnabled") {
-    FrameCryptorSetEnabled(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorGetEnabled") {
-    FrameCryptorGetEnabled(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorDispose") {
-    FrameCryptorDispose(params, std::move(result));
-    return true;
-  } else if (method_name == "frameCryptorFactoryCreateKeyProvider") {
-    FrameCryptorFactoryCreateKeyProvider(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderSetSharedKey") {
-    KeyProviderSetSharedKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderRatchetSharedKey") {
-    KeyProviderRatchetSharedKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderExportSharedKey") {
-    KeyProviderExportSharedKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderSetKey") {
-    KeyProviderSetKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderRatchetKey") {
-    KeyProviderRatchetKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderExportKey") {
-    KeyProviderExportKey(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderSetSifTrailer") {
-    KeyProviderSetSifTrailer(params, std::move(result));
-    return true;
-  } else if (method_name == "keyProviderDispose") {
-    KeyProviderDispose(params, std::move(result));
-    return true;
-  }
-
-  *outResult = std::move(result);
-  return false;
+void FlutterFrameCryptor::RegisterFrameCryptorMethods(
+    FlutterMethodDispatcher* dispatcher) {
+  using Handler = void (FlutterFrameCryptor::*)(
+      const EncodableMap&, std::unique_ptr<MethodResultProxy>);
+  static const std::pair<const char*, Handler> kMethods[] = {
+      {"frameCryptorFactoryCreateFrameCryptor",
+       &FlutterFrameCryptor::FrameCryptorFactoryCreateFrameCryptor},
+      {"frameCryptorSetKeyIndex",
+       &FlutterFrameCryptor::FrameCryptorSetKeyIndex},
+      {"frameCryptorGetKeyIndex",
+       &FlutterFrameCryptor::FrameCryptorGetKeyIndex},
+      {"frameCryptorSetEnabled", &FlutterFrameCryptor::FrameCryptorSetEnabled},
+      {"frameCryptorGetEnabled", &FlutterFrameCryptor::FrameCryptorGetEnabled},
+      {"frameCryptorDispose", &FlutterFrameCryptor::FrameCryptorDispose},
+      {"frameCryptorFactoryCreateKeyProvider",
+       &FlutterFrameCryptor::FrameCryptorFactoryCreateKeyProvider},
+      {"keyProviderSetSharedKey",
+       &FlutterFrameCryptor::KeyProviderSetSharedKey},
+      {"keyProviderRatchetSharedKey",
+       &FlutterFrameCryptor::KeyProviderRatchetSharedKey},
+      {"keyProviderExportSharedKey",
+       &FlutterFrameCryptor::KeyProviderExportSharedKey},
+      {"keyProviderSetKey", &FlutterFrameCryptor::KeyProviderSetKey},
+      {"keyProviderRatchetKey", &FlutterFrameCryptor::KeyProviderRatchetKey},
+      {"keyProviderExportKey", &FlutterFrameCryptor::KeyProviderExportKey},
+      {"keyProviderSetSifTrailer",
+       &FlutterFrameCryptor::KeyProviderSetSifTrailer},
+      {"keyProviderDispose", &FlutterFrameCryptor::KeyProviderDispose},
+  };
+  for (const auto& method : kMethods) {
+    Handler handler = method.second;
+    dispatcher->RegisterWithParams(
+        method.first,
+        [this, handler](const EncodableMap& params,
+                        std::unique_ptr<MethodResultProxy> result) {
+          (this->*handler)(params, std::move(result));
+        });
+  }
 }
 
 void FlutterFrameCryptor::FrameCryptorFactoryCreateFrameCryptor(
@@ -326,7 +310,7 @@ void FlutterFrameCryptor::FrameCryptorFactoryCreateKeyProvider(
     std::unique_ptr<MethodResultProxy> result) {
   libwebrtc::KeyProviderOptions options;
 
-  auto keyProviderOptions = findMap(constraints, "keyProviderOptions");
+  const auto& keyProviderOptions = findMap(constraints, "keyProviderOptions");
   if (keyProviderOptions == EncodableMap()) {
     result->Error("FrameCryptorFactoryCreateKeyProviderFailed",
                   "keyProviderOptions is null");
@@ -336,13 +320,13 @@ void FlutterFrameCryptor::FrameCryptorFactoryCreateKeyProvider(
   auto sharedKey = findBoolean(keyProviderOptions, "sharedKey");
   options.shared_key = sharedKey;
 
-  auto uncryptedMagicBytes =
+  const auto& uncryptedMagicBytes =
       findVector(keyProviderOptions, "uncryptedMagicBytes");
   if (uncryptedMagicBytes.size() != 0) {
     options.uncrypted_magic_bytes = uncryptedMagicBytes;
   }
 
-  auto ratchetSalt = findVector(keyProviderOptions, "ratchetSalt");
+  const auto& ratchetSalt = findVector(keyProviderOptions, "ratchetSalt");
   if (ratchetSalt.size() == 0) {
     result->Error("FrameCryptorFactoryCreateKeyProviderFailed",
                   "ratchetSalt is null");
@@ -402,7 +386,7 @@ void FlutterFrameCryptor::KeyProviderSetSharedKey(
     return;
   }
 
-  auto key = findVector(constraints, "key");
+  const auto& key = findVector(constraints, "key");
   if (key.size() == 0) {
     result->Error("KeyProviderSetSharedKeyFailed", "key is null");
     return;
@@ -525,7 +509,7 @@ void FlutterFrameCryptor::KeyProviderSetSifTrailer(
     return;
   }
 
-  auto sifTrailer = findVector(constraints, "sifTrailer");
+  const auto& sifTrailer = findVector(constraints, "sifTrailer");
   if (sifTrailer.size() == 0) {
     result->Error("KeyProviderSetSifTrailerFailed", "sifTrailer is null");
     return;
@@ -552,7 +536,7 @@ void FlutterFrameCryptor::KeyProviderSetKey(
     return;
   }
 
-  auto key = findVector(constraints, "key");
+  const auto& key = findVector(constraints, "key");
   if (key.size() == 0) {
     result->Error("KeyProviderSetKeyFailed", "key is null");
     return;
@@ -0,0 +1,186 @@
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "flutter_frame_dump.h"
+
+#include <cinttypes>
+
+namespace flutter_webrtc_plugin {
+
+FlutterFrameDump::FlutterFrameDump(scoped_refptr<RTCVideoTrack> track,
+                                   std::string path,
+                                   int64_t max_frames)
+    : track_(track), path_(path), max_frames_(max_frames) {}
+
+FlutterFrameDump::~FlutterFrameDump() {
+  if (writer_.joinable()) {
+    Stop();
+  }
+}
+
+bool FlutterFrameDump::Start() {
+  std::string timestamps_path = path_ + ".timestamps";
+  if (!y4m_.Open(path_)) {
+    return false;
+  }
+  timestamps_ = fopen(timestamps_path.c_str(), "w");
+  if (!timestamps_) {
+    y4m_.Close();
+    remove(path_.c_str());
+    return false;
+  }
+  queue_ = std::make_unique<VideoFrameQueue>(kQueueFrames);
+  start_time_ = std::chrono::steady_clock::now();
+  writer_ = std::thread([this] { WriterLoop(); });
+  track_->AddRenderer(this);
+  return true;
+}
+
+bool FlutterFrameDump::Stop() {
+  track_->RemoveRenderer(this);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  bool closed = y4m_.Close();
+  if (timestamps_) {
+    closed = fclose(timestamps_) == 0 && closed;
+    timestamps_ = nullptr;
+  }
+  return closed && !failed_;
+}
+
+void FlutterFrameDump::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  int64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start_time_)
+                             .count();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_ || (max_frames_ > 0 && frames_accepted_ >= max_frames_)) {
+      return;
+    }
+  }
+  bool queued = queue_->Push(frame.get(), timestamp_us);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!queued) {
+      frames_dropped_++;
+      return;
+    }
+    frames_accepted_++;
+    work_pending_ = true;
+  }
+  wake_.notify_one();
+}
+
+void FlutterFrameDump::WriterLoop() {
+  while (true) {
+    bool stopping;
+    bool failed;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return stopping_ || work_pending_; });
+      work_pending_ = false;
+      stopping = stopping_;
+      failed = failed_;
+    }
+    if (!failed && !Drain()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = true;
+    }
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+bool FlutterFrameDump::Drain() {
+  while (const VideoFrameQueue::Frame* frame = queue_->Front()) {
+    if ((frame->width != y4m_.width() || frame->height != y4m_.height()) &&
+        !y4m_.StartSegment(frame->width, frame->height, 30)) {
+      return false;
+    }
+    if (!y4m_.WriteFrame(frame->data.data(), frame->data.size()) ||
+        fprintf(timestamps_, "%" PRId64 " %" PRId64 " %d %d %d\n",
+                frames_written_, frame->timestamp_us, frame->width,
+                frame->height, frame->rotation) < 0) {
+      return false;
+    }
+    frames_written_++;
+    queue_->Pop();
+  }
+  return true;
+}
+
+FlutterFrameDumpManager::FlutterFrameDumpManager(FlutterWebRTCBase* base)
+    : base_(base) {}
+
+FlutterFrameDumpManager::~FlutterFrameDumpManager() {
+  for (auto& dump : dumps_) {
+    dump.second->Stop();
+  }
+}
+
+void FlutterFrameDumpManager::StartFrameDump(
+    const EncodableMap& params,
+    std::unique_ptr<MethodResultProxy> result) {
+  std::string track_id = findString(params, "trackId");
+  std::string path = findString(params, "path");
+  if (path.empty()) {
+    result->Error("videoTrackStartDump", "videoTrackStartDump() path is empty");
+    return;
+  }
+  RTCMediaTrack* track = base_->MediaTrackForId(track_id);
+  if (nullptr == track || track->kind().std_string() != "video") {
+    result->Error("videoTrackStartDump",
+                  "videoTrackStartDump() video track not found");
+    return;
+  }
+  if (dumps_.find(track_id) != dumps_.end()) {
+    result->Error("videoTrackStartDump",
+                  "videoTrackStartDump() track is already being dumped");
+    return;
+  }
+  int64_t max_frames = findLongInt(params, "maxFrames");
+  auto dump = std::make_unique<FlutterFrameDump>(
+      static_cast<RTCVideoTrack*>(track), path,
+      max_frames > 0 ? max_frames : 0);
+  if (!dump->Start()) {
+    result->Error("videoTrackStartDump",
+                  "videoTrackStartDump() could not create the dump files");
+    return;
+  }
+  dumps_[track_id] = std::move(dump);
+  result->Success();
+}
+
+void FlutterFrameDumpManager::StopFrameDump(
+    const std::string& track_id,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = dumps_.find(track_id);
+  if (it == dumps_.end()) {
+    result->Error("videoTrackStopDump", "videoTrackStopDump() dump not found");
+    return;
+  }
+  std::unique_ptr<FlutterFrameDump> dump = std::move(it->second);
+  dumps_.erase(it);
+  if (!dump->Stop()) {
+    result->Error("videoTrackStopDump",
+                  "videoTrackStopDump() failed to write the dump");
+    return;
+  }
+  EncodableMap response;
+  response[EncodableValue("frames")] = EncodableValue(dump->frames_written());
+  response[EncodableValue("dropped")] =
+      EncodableValue(static_cast<int64_t>(dump->frames_dropped()));
+  response[EncodableValue("segments")] =
+      EncodableValue(static_cast<int64_t>(dump->segments()));
+  result->Success(EncodableValue(response));
+}
+
+}  // namespace flutter_webrtc_plugin
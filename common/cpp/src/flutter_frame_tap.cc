@@ -0,0 +1,244 @@
+#include "flutter_frame_tap.h"
+#include "flutter_video_frame_converter.h"
+#include "task_runner.h"
+
+#include <algorithm>
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+void PutLittleEndian(uint8_t* dst, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    dst[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+// Averages the Y plane over the source area of each output pixel, reading
+// the frame rotated upright by |rotation| degrees clockwise.
+void DownscaleLuma(const YuvPlanes& src,
+                   int rotation,
+                   uint8_t* dst,
+                   size_t dst_width,
+                   size_t dst_height) {
+  bool transpose = rotation == 90 || rotation == 270;
+  size_t upright_width = transpose ? src.height : src.width;
+  size_t upright_height = transpose ? src.width : src.height;
+  for (size_t y = 0; y < dst_height; y++) {
+    size_t top = y * upright_height / dst_height;
+    size_t bottom = std::max(top + 1, (y + 1) * upright_height / dst_height);
+    for (size_t x = 0; x < dst_width; x++) {
+      size_t left = x * upright_width / dst_width;
+      size_t right = std::max(left + 1, (x + 1) * upright_width / dst_width);
+      uint32_t sum = 0;
+      for (size_t uy = top; uy < bottom; uy++) {
+        for (size_t ux = left; ux < right; ux++) {
+          size_t fx = ux;
+          size_t fy = uy;
+          switch (rotation) {
+            case 90:
+              fx = uy;
+              fy = src.height - 1 - ux;
+              break;
+            case 180:
+              fx = src.width - 1 - ux;
+              fy = src.height - 1 - uy;
+              break;
+            case 270:
+              fx = src.width - 1 - uy;
+              fy = ux;
+              break;
+          }
+          sum += src.y[fy * src.stride_y + fx];
+        }
+      }
+      uint32_t count = static_cast<uint32_t>((bottom - top) * (right - left));
+      dst[y * dst_width + x] = static_cast<uint8_t>((sum + count / 2) / count);
+    }
+  }
+}
+
+}  // namespace
+
+constexpr size_t FlutterFrameTap::kHeaderSize;
+
+FlutterFrameTap::FlutterFrameTap(scoped_refptr<RTCVideoTrack> track,
+                                 BinaryMessenger* messenger,
+                                 TaskRunner* task_runner,
+                                 std::string channel,
+                                 double fps,
+                                 size_t width,
+                                 size_t height,
+                                 Format format)
+    : track_(track),
+      messenger_(messenger),
+      task_runner_(task_runner),
+      channel_(channel),
+      interval_(fps > 0
+                    ? std::chrono::duration_cast<
+                          std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(1.0 / fps))
+                    : std::chrono::steady_clock::duration::zero()),
+      width_(width),
+      height_(height),
+      format_(format) {}
+
+void FlutterFrameTap::Start() {
+  track_->AddRenderer(this);
+}
+
+void FlutterFrameTap::Stop() {
+  track_->RemoveRenderer(this);
+}
+
+void FlutterFrameTap::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  if (ShouldDropFrame()) {
+    return;
+  }
+  uint32_t sequence;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sequence = ++sequence_;
+    if (busy_) {
+      return;
+    }
+    busy_ = true;
+  }
+  FillMessage(frame, sequence);
+  if (task_runner_) {
+    std::shared_ptr<FlutterFrameTap> self = shared_from_this();
+    task_runner_->EnqueueTask([self] { self->Send(); },
+                              TaskPriority::kBulkData);
+  } else {
+    Send();
+  }
+}
+
+bool FlutterFrameTap::ShouldDropFrame() {
+  if (interval_ == std::chrono::steady_clock::duration::zero()) {
+    return false;
+  }
+  // Same pacing as the renderers' frame rate cap.
+  auto now = std::chrono::steady_clock::now();
+  if (now < next_frame_time_) {
+    return true;
+  }
+  next_frame_time_ += interval_;
+  if (next_frame_time_ <= now) {
+    next_frame_time_ = now + interval_;
+  }
+  return false;
+}
+
+void FlutterFrameTap::FillMessage(scoped_refptr<RTCVideoFrame> frame,
+                                  uint32_t sequence) {
+  int rotation = static_cast<int>(frame->rotation());
+  bool transpose = rotation == 90 || rotation == 270;
+  size_t upright_width = transpose ? frame->height() : frame->width();
+  size_t upright_height = transpose ? frame->width() : frame->height();
+  size_t width = width_;
+  size_t height = height_;
+  if (width == 0 && height == 0) {
+    width = upright_width;
+    height = upright_height;
+  } else if (height == 0) {
+    height = std::max<size_t>(1, upright_height * width / upright_width);
+  } else if (width == 0) {
+    width = std::max<size_t>(1, upright_width * height / upright_height);
+  }
+
+  size_t bytes_per_pixel = format_ == Format::kRGB ? 3 : 1;
+  message_.resize(kHeaderSize + width * height * bytes_per_pixel);
+  uint8_t* header = message_.data();
+  PutLittleEndian(header, width, 4);
+  PutLittleEndian(header + 4, height, 4);
+  PutLittleEndian(header + 8, static_cast<uint8_t>(format_), 4);
+  PutLittleEndian(header + 12, sequence, 4);
+  int64_t timestamp_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  PutLittleEndian(header + 16, static_cast<uint64_t>(timestamp_us), 8);
+
+  uint8_t* pixels = header + kHeaderSize;
+  YuvPlanes planes = YuvPlanesFromFrame(frame.get());
+  if (format_ == Format::kLuma) {
+    DownscaleLuma(planes, rotation, pixels, width, height);
+    return;
+  }
+  rgba_.resize(width * height * 4);
+  ConvertYuvToRgb(planes, RgbFormat::kRGBA, rotation, rgba_.data(),
+                  static_cast<int>(width * 4), static_cast<int>(width),
+                  static_cast<int>(height));
+  const uint8_t* src = rgba_.data();
+  for (size_t i = 0; i < width * height; i++) {
+    pixels[3 * i] = src[4 * i];
+    pixels[3 * i + 1] = src[4 * i + 1];
+    pixels[3 * i + 2] = src[4 * i + 2];
+  }
+}
+
+void FlutterFrameTap::Send() {
+  // The messenger copies the message, so the buffer is free again as soon as
+  // Send() returns.
+  messenger_->Send(channel_, message_.data(), message_.size());
+  std::lock_guard<std::mutex> lock(mutex_);
+  busy_ = false;
+}
+
+FlutterFrameTapManager::FlutterFrameTapManager(FlutterWebRTCBase* base)
+    : base_(base) {}
+
+FlutterFrameTapManager::~FlutterFrameTapManager() {
+  for (auto& tap : taps_) {
+    tap.second->Stop();
+  }
+}
+
+void FlutterFrameTapManager::StartFrameTap(
+    scoped_refptr<RTCVideoTrack> track,
+    const EncodableMap& params,
+    std::unique_ptr<MethodResultProxy> result) {
+  FlutterFrameTap::Format format = FlutterFrameTap::Format::kRGB;
+  std::string format_name = findString(params, "format");
+  if (format_name == "y") {
+    format = FlutterFrameTap::Format::kLuma;
+  } else if (!format_name.empty() && format_name != "rgb") {
+    result->Error("videoTrackStartFrameTap",
+                  "videoTrackStartFrameTap() unsupported format " +
+                      format_name);
+    return;
+  }
+  int width = findInt(params, "width");
+  int height = findInt(params, "height");
+
+  std::string tap_id = base_->GenerateUUID();
+  std::string channel = "FlutterWebRTC/frameTap/" + tap_id;
+  auto tap = std::make_shared<FlutterFrameTap>(
+      track, base_->messenger_, base_->task_runner_, channel,
+      findDouble(params, "fps"), width > 0 ? width : 0,
+      height > 0 ? height : 0, format);
+  tap->Start();
+  taps_[tap_id] = tap;
+
+  EncodableMap response;
+  response[EncodableValue("tapId")] = EncodableValue(tap_id);
+  response[EncodableValue("channel")] = EncodableValue(channel);
+  result->Success(EncodableValue(response));
+}
+
+void FlutterFrameTapManager::StopFrameTap(
+    const std::string& tap_id,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = taps_.find(tap_id);
+  if (it == taps_.end()) {
+    result->Error("videoTrackStopFrameTap",
+                  "videoTrackStopFrameTap() tap not found");
+    return;
+  }
+  it->second->Stop();
+  taps_.erase(it);
+  result->Success();
+}
+
+}  // namespace flutter_webrtc_plugin
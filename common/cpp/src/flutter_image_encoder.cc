@@ -0,0 +1,1033 @@
+#include "flutter_image_encoder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// Bands smaller than this are not worth a thread.
+constexpr int kMinRowsPerBand = 64;
+
+struct Bands {
+  int count;
+  int units_per_band;
+};
+
+// Splits |units| (rows, or rows of JPEG blocks) into one band per core, each
+// at least |min_units| long. Every band but the last has the same size.
+Bands SplitIntoBands(int units, int min_units) {
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+  int count = std::max(1, std::min(cores, units / std::max(1, min_units)));
+  int per_band = (units + count - 1) / count;
+  return {(units + per_band - 1) / per_band, per_band};
+}
+
+// Runs |encode| for every band, the first one on the calling thread.
+void ForEachBand(int count, const std::function<void(int)>& encode) {
+  std::vector<std::thread> threads;
+  for (int i = 1; i < count; i++) {
+    threads.emplace_back(encode, i);
+  }
+  encode(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void AppendBigEndian32(std::vector<uint8_t>* out, uint32_t value) {
+  out->push_back(static_cast<uint8_t>(value >> 24));
+  out->push_back(static_cast<uint8_t>(value >> 16));
+  out->push_back(static_cast<uint8_t>(value >> 8));
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+void AppendBigEndian16(std::vector<uint8_t>* out, uint16_t value) {
+  out->push_back(static_cast<uint8_t>(value >> 8));
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+int FloorLog2(uint32_t value) {
+  int log = 0;
+  while (value >>= 1) {
+    log++;
+  }
+  return log;
+}
+
+// PNG
+
+constexpr uint32_t kAdlerBase = 65521;
+
+uint32_t Adler32(const uint8_t* data, size_t length) {
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (length > 0) {
+    // Largest run that cannot overflow |b| before the modulo.
+    size_t chunk = std::min<size_t>(length, 5552);
+    length -= chunk;
+    while (chunk--) {
+      a += *data++;
+      b += a;
+    }
+    a %= kAdlerBase;
+    b %= kAdlerBase;
+  }
+  return (b << 16) | a;
+}
+
+// Checksum of the concatenation of two buffers from their own checksums.
+uint32_t Adler32Combine(uint32_t adler1, uint32_t adler2, size_t length2) {
+  uint64_t remainder = length2 % kAdlerBase;
+  uint64_t sum1 = adler1 & 0xffff;
+  uint64_t sum2 = (remainder * sum1) % kAdlerBase;
+  sum1 += (adler2 & 0xffff) + kAdlerBase - 1;
+  sum2 += (adler1 >> 16) + (adler2 >> 16) + kAdlerBase - remainder;
+  sum1 %= kAdlerBase;
+  sum2 %= kAdlerBase;
+  return static_cast<uint32_t>((sum2 << 16) | sum1);
+}
+
+uint32_t Crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+  static const auto table = [] {
+    std::vector<uint32_t> table(256);
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    return table;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void AppendPngChunk(std::vector<uint8_t>* out,
+                    const char* type,
+                    const uint8_t* data,
+                    size_t length) {
+  AppendBigEndian32(out, static_cast<uint32_t>(length));
+  size_t start = out->size();
+  out->insert(out->end(), type, type + 4);
+  out->insert(out->end(), data, data + length);
+  AppendBigEndian32(out, Crc32(out->data() + start, length + 4));
+}
+
+constexpr uint16_t kLengthBase[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtraBits[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                          1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                          4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+constexpr uint8_t kDistanceExtraBits[30] = {0, 0, 0,  0,  1,  1,  2,  2,
+                                            3, 3, 4,  4,  5,  5,  6,  6,
+                                            7, 7, 8,  8,  9,  9,  10, 10,
+                                            11, 11, 12, 12, 13, 13};
+
+int LengthCode(int length) {
+  if (length == 258) {
+    return 28;
+  }
+  int value = length - 3;
+  if (value < 8) {
+    return value;
+  }
+  int log = FloorLog2(value);
+  return 4 * (log - 1) + ((value >> (log - 2)) & 3);
+}
+
+int DistanceCode(int distance) {
+  int value = distance - 1;
+  if (value < 4) {
+    return value;
+  }
+  int log = FloorLog2(value);
+  return 2 * log + ((value >> (log - 1)) & 1);
+}
+
+uint16_t ReverseBits(uint16_t code, int bits) {
+  uint16_t reversed = 0;
+  for (int i = 0; i < bits; i++) {
+    reversed = static_cast<uint16_t>((reversed << 1) | ((code >> i) & 1));
+  }
+  return reversed;
+}
+
+// The fixed Huffman codes of RFC 1951 3.2.6, bit-reversed for LSB-first
+// output.
+struct FixedHuffmanCodes {
+  uint16_t literal_code[288];
+  uint8_t literal_bits[288];
+  uint16_t distance_code[30];
+
+  FixedHuffmanCodes() {
+    for (int symbol = 0; symbol < 288; symbol++) {
+      uint16_t code;
+      int bits;
+      if (symbol < 144) {
+        code = static_cast<uint16_t>(0x30 + symbol);
+        bits = 8;
+      } else if (symbol < 256) {
+        code = static_cast<uint16_t>(0x190 + symbol - 144);
+        bits = 9;
+      } else if (symbol < 280) {
+        code = static_cast<uint16_t>(symbol - 256);
+        bits = 7;
+      } else {
+        code = static_cast<uint16_t>(0xc0 + symbol - 280);
+        bits = 8;
+      }
+      literal_code[symbol] = ReverseBits(code, bits);
+      literal_bits[symbol] = static_cast<uint8_t>(bits);
+    }
+    for (int symbol = 0; symbol < 30; symbol++) {
+      distance_code[symbol] = ReverseBits(static_cast<uint16_t>(symbol), 5);
+    }
+  }
+};
+
+class DeflateBitWriter {
+ public:
+  explicit DeflateBitWriter(std::vector<uint8_t>* out) : out_(out) {}
+
+  void PutBits(uint32_t bits, int count) {
+    buffer_ |= static_cast<uint64_t>(bits) << count_;
+    count_ += count;
+    while (count_ >= 8) {
+      out_->push_back(static_cast<uint8_t>(buffer_));
+      buffer_ >>= 8;
+      count_ -= 8;
+    }
+  }
+
+  void AlignToByte() {
+    if (count_ > 0) {
+      out_->push_back(static_cast<uint8_t>(buffer_));
+      buffer_ = 0;
+      count_ = 0;
+    }
+  }
+
+ private:
+  std::vector<uint8_t>* out_;
+  uint64_t buffer_ = 0;
+  int count_ = 0;
+};
+
+// Compresses |data| as one non-final fixed-Huffman block followed by an
+// empty stored block, so the output ends byte-aligned and can be followed by
+// the next band's blocks. Matches are found with a hash chain over the
+// previous 32 KiB of the band.
+void DeflateBand(const uint8_t* data,
+                 size_t length,
+                 std::vector<uint8_t>* out) {
+  constexpr int kHashBits = 15;
+  constexpr int kWindowSize = 32768;
+  constexpr int kMinMatch = 3;
+  constexpr int kMaxMatch = 258;
+  constexpr int kMaxChain = 16;
+  constexpr int kNiceMatch = 128;
+  // Positions inside longer matches are not added to the hash chains.
+  constexpr int kMaxInsertLength = 16;
+  static const FixedHuffmanCodes codes;
+
+  std::vector<int32_t> head(1 << kHashBits, -1);
+  std::vector<int32_t> previous(kWindowSize, -1);
+  auto hash = [data](size_t pos) {
+    uint32_t value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16);
+    return (value * 2654435761u) >> (32 - kHashBits);
+  };
+  auto insert = [&](size_t pos) {
+    uint32_t h = hash(pos);
+    previous[pos & (kWindowSize - 1)] = head[h];
+    head[h] = static_cast<int32_t>(pos);
+  };
+
+  DeflateBitWriter writer(out);
+  // BFINAL = 0, BTYPE = 01 (fixed Huffman).
+  writer.PutBits(0, 1);
+  writer.PutBits(1, 2);
+
+  size_t pos = 0;
+  while (pos < length) {
+    int best_length = 0;
+    int best_distance = 0;
+    if (pos + kMinMatch <= length) {
+      int max_length = static_cast<int>(
+          std::min<size_t>(kMaxMatch, length - pos));
+      int32_t candidate = head[hash(pos)];
+      for (int chain = 0; chain < kMaxChain && candidate >= 0; chain++) {
+        int distance = static_cast<int>(pos - candidate);
+        if (distance > kWindowSize) {
+          break;
+        }
+        const uint8_t* a = data + candidate;
+        const uint8_t* b = data + pos;
+        // A candidate can only beat the best match if the byte after that
+        // match agrees too.
+        if (best_length == 0 ||
+            (best_length < max_length && a[best_length] == b[best_length])) {
+          int match = 0;
+          while (match + 8 <= max_length) {
+            uint64_t word_a;
+            uint64_t word_b;
+            memcpy(&word_a, a + match, 8);
+            memcpy(&word_b, b + match, 8);
+            if (word_a != word_b) {
+              break;
+            }
+            match += 8;
+          }
+          while (match < max_length && a[match] == b[match]) {
+            match++;
+          }
+          if (match > best_length) {
+            best_length = match;
+            best_distance = distance;
+            if (match >= kNiceMatch) {
+              break;
+            }
+          }
+        }
+        int32_t next = previous[candidate & (kWindowSize - 1)];
+        if (next >= candidate) {
+          break;
+        }
+        candidate = next;
+      }
+    }
+
+    if (best_length >= kMinMatch) {
+      int length_code = LengthCode(best_length);
+      int symbol = 257 + length_code;
+      writer.PutBits(codes.literal_code[symbol], codes.literal_bits[symbol]);
+      writer.PutBits(best_length - kLengthBase[length_code],
+                     kLengthExtraBits[length_code]);
+      int distance_code = DistanceCode(best_distance);
+      writer.PutBits(codes.distance_code[distance_code], 5);
+      writer.PutBits(best_distance - kDistanceBase[distance_code],
+                     kDistanceExtraBits[distance_code]);
+      size_t end = pos + best_length;
+      if (best_length > kMaxInsertLength) {
+        insert(pos);
+        pos = end;
+      }
+      for (; pos < end; pos++) {
+        if (pos + kMinMatch <= length) {
+          insert(pos);
+        }
+      }
+    } else {
+      if (pos + kMinMatch <= length) {
+        insert(pos);
+      }
+      writer.PutBits(codes.literal_code[data[pos]],
+                     codes.literal_bits[data[pos]]);
+      pos++;
+    }
+  }
+  writer.PutBits(codes.literal_code[256], codes.literal_bits[256]);
+
+  // Empty non-final stored block: BFINAL = 0, BTYPE = 00, LEN = 0, NLEN.
+  writer.PutBits(0, 3);
+  writer.AlignToByte();
+  const uint8_t kEmptyStoredLengths[] = {0x00, 0x00, 0xff, 0xff};
+  out->insert(out->end(), kEmptyStoredLengths, kEmptyStoredLengths + 4);
+}
+
+uint8_t Paeth(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = std::abs(p - a);
+  int pb = std::abs(p - b);
+  int pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return static_cast<uint8_t>(a);
+  }
+  return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+// Writes the filter type byte and the filtered |row| to |out|, picking the
+// filter with the smallest sum of absolute values. |prior| is the unfiltered
+// row above, or nullptr for the first row of the image.
+void FilterRow(const uint8_t* row,
+               const uint8_t* prior,
+               size_t length,
+               std::vector<uint8_t>* scratch,
+               uint8_t* out) {
+  constexpr size_t kBpp = 3;
+  constexpr int kFilterCount = 5;
+  // One row per filter, then a row of zeros standing in for a missing
+  // |prior|.
+  scratch->resize(length * (kFilterCount + 1));
+  uint8_t* filtered_rows = scratch->data();
+  if (!prior) {
+    uint8_t* zeros = filtered_rows + length * kFilterCount;
+    memset(zeros, 0, length);
+    prior = zeros;
+  }
+  uint8_t* none = filtered_rows;
+  uint8_t* sub = none + length;
+  uint8_t* up = sub + length;
+  uint8_t* average = up + length;
+  uint8_t* paeth = average + length;
+  memcpy(none, row, length);
+  for (size_t i = 0; i < kBpp && i < length; i++) {
+    sub[i] = row[i];
+    up[i] = static_cast<uint8_t>(row[i] - prior[i]);
+    average[i] = static_cast<uint8_t>(row[i] - prior[i] / 2);
+    paeth[i] = static_cast<uint8_t>(row[i] - prior[i]);
+  }
+  for (size_t i = kBpp; i < length; i++) {
+    int a = row[i - kBpp];
+    int b = prior[i];
+    int c = prior[i - kBpp];
+    sub[i] = static_cast<uint8_t>(row[i] - a);
+    up[i] = static_cast<uint8_t>(row[i] - b);
+    average[i] = static_cast<uint8_t>(row[i] - (a + b) / 2);
+    paeth[i] = static_cast<uint8_t>(row[i] - Paeth(a, b, c));
+  }
+
+  uint64_t best_cost = UINT64_MAX;
+  int best_filter = 0;
+  for (int filter = 0; filter < kFilterCount; filter++) {
+    const uint8_t* filtered = filtered_rows + filter * length;
+    uint64_t cost = 0;
+    for (size_t i = 0; i < length; i++) {
+      cost += std::abs(static_cast<int8_t>(filtered[i]));
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_filter = filter;
+    }
+  }
+  out[0] = static_cast<uint8_t>(best_filter);
+  memcpy(out + 1, filtered_rows + best_filter * length, length);
+}
+
+void RgbaRowToRgb(const uint8_t* rgba, int width, uint8_t* rgb) {
+  for (int x = 0; x < width; x++) {
+    rgb[3 * x] = rgba[4 * x];
+    rgb[3 * x + 1] = rgba[4 * x + 1];
+    rgb[3 * x + 2] = rgba[4 * x + 2];
+  }
+}
+
+std::vector<uint8_t> EncodePng(const uint8_t* rgba,
+                               int width,
+                               int height,
+                               int stride) {
+  struct Band {
+    std::vector<uint8_t> deflated;
+    uint32_t adler;
+    size_t length;
+  };
+  size_t row_bytes = static_cast<size_t>(width) * 3;
+  Bands bands = SplitIntoBands(height, kMinRowsPerBand);
+  std::vector<Band> encoded(bands.count);
+
+  ForEachBand(bands.count, [&](int band) {
+    int first_row = band * bands.units_per_band;
+    int last_row = std::min(height, first_row + bands.units_per_band);
+    std::vector<uint8_t> filtered((row_bytes + 1) * (last_row - first_row));
+    std::vector<uint8_t> prior(row_bytes);
+    std::vector<uint8_t> current(row_bytes);
+    std::vector<uint8_t> scratch;
+    if (first_row > 0) {
+      RgbaRowToRgb(rgba + static_cast<size_t>(first_row - 1) * stride, width,
+                   prior.data());
+    }
+    for (int y = first_row; y < last_row; y++) {
+      RgbaRowToRgb(rgba + static_cast<size_t>(y) * stride, width,
+                   current.data());
+      FilterRow(current.data(), y > 0 ? prior.data() : nullptr, row_bytes,
+                &scratch,
+                filtered.data() + (row_bytes + 1) * (y - first_row));
+      std::swap(prior, current);
+    }
+    Band& out = encoded[band];
+    out.deflated.reserve(filtered.size() / 2);
+    DeflateBand(filtered.data(), filtered.size(), &out.deflated);
+    out.adler = Adler32(filtered.data(), filtered.size());
+    out.length = filtered.size();
+  });
+
+  std::vector<uint8_t> idat = {0x78, 0x01};
+  uint32_t adler = 1;
+  for (const Band& band : encoded) {
+    idat.insert(idat.end(), band.deflated.begin(), band.deflated.end());
+    adler = Adler32Combine(adler, band.adler, band.length);
+  }
+  // Final empty stored block.
+  const uint8_t kFinalBlock[] = {0x01, 0x00, 0x00, 0xff, 0xff};
+  idat.insert(idat.end(), kFinalBlock, kFinalBlock + 5);
+  AppendBigEndian32(&idat, adler);
+
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  std::vector<uint8_t> header;
+  AppendBigEndian32(&header, width);
+  AppendBigEndian32(&header, height);
+  // 8-bit RGB, deflate, adaptive filtering, no interlacing.
+  const uint8_t kHeaderTail[] = {8, 2, 0, 0, 0};
+  header.insert(header.end(), kHeaderTail, kHeaderTail + 5);
+  AppendPngChunk(&png, "IHDR", header.data(), header.size());
+  AppendPngChunk(&png, "IDAT", idat.data(), idat.size());
+  AppendPngChunk(&png, "IEND", nullptr, 0);
+  return png;
+}
+
+// QOI
+
+struct QoiPixel {
+  uint8_t r, g, b;
+
+  bool operator==(const QoiPixel& other) const {
+    return r == other.r && g == other.g && b == other.b;
+  }
+};
+
+void EncodeQoiBand(const uint8_t* rgba,
+                   int width,
+                   int stride,
+                   int first_row,
+                   int last_row,
+                   std::vector<uint8_t>* out) {
+  constexpr uint8_t kOpIndex = 0x00;
+  constexpr uint8_t kOpDiff = 0x40;
+  constexpr uint8_t kOpLuma = 0x80;
+  constexpr uint8_t kOpRun = 0xc0;
+  constexpr uint8_t kOpRgb = 0xfe;
+
+  // The decoder's index is not known at the start of a band, so the band
+  // starts with an empty one. The previous pixel is: it is the last pixel of
+  // the band before.
+  QoiPixel index[64];
+  bool index_valid[64] = {};
+  QoiPixel previous = {0, 0, 0};
+  if (first_row > 0) {
+    const uint8_t* last =
+        rgba + static_cast<size_t>(first_row - 1) * stride + 4 * (width - 1);
+    previous = {last[0], last[1], last[2]};
+  }
+
+  int run = 0;
+  for (int y = first_row; y < last_row; y++) {
+    const uint8_t* row = rgba + static_cast<size_t>(y) * stride;
+    for (int x = 0; x < width; x++) {
+      QoiPixel pixel = {row[4 * x], row[4 * x + 1], row[4 * x + 2]};
+      if (pixel == previous) {
+        if (++run == 62) {
+          out->push_back(kOpRun | (run - 1));
+          run = 0;
+        }
+        continue;
+      }
+      if (run > 0) {
+        out->push_back(kOpRun | (run - 1));
+        run = 0;
+      }
+      // Alpha is always 255, hence the 255 * 11.
+      int hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + 255 * 11) % 64;
+      if (index_valid[hash] && index[hash] == pixel) {
+        out->push_back(kOpIndex | hash);
+      } else {
+        index[hash] = pixel;
+        index_valid[hash] = true;
+        int dr = static_cast<int8_t>(pixel.r - previous.r);
+        int dg = static_cast<int8_t>(pixel.g - previous.g);
+        int db = static_cast<int8_t>(pixel.b - previous.b);
+        int dr_dg = dr - dg;
+        int db_dg = db - dg;
+        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 &&
+            db <= 1) {
+          out->push_back(static_cast<uint8_t>(kOpDiff | (dr + 2) << 4 |
+                                              (dg + 2) << 2 | (db + 2)));
+        } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 &&
+                   db_dg >= -8 && db_dg <= 7) {
+          out->push_back(static_cast<uint8_t>(kOpLuma | (dg + 32)));
+          out->push_back(static_cast<uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+        } else {
+          out->push_back(kOpRgb);
+          out->push_back(pixel.r);
+          out->push_back(pixel.g);
+          out->push_back(pixel.b);
+        }
+      }
+      previous = pixel;
+    }
+  }
+  if (run > 0) {
+    out->push_back(kOpRun | (run - 1));
+  }
+}
+
+std::vector<uint8_t> EncodeQoi(const uint8_t* rgba,
+                               int width,
+                               int height,
+                               int stride) {
+  Bands bands = SplitIntoBands(height, kMinRowsPerBand);
+  std::vector<std::vector<uint8_t>> encoded(bands.count);
+  ForEachBand(bands.count, [&](int band) {
+    int first_row = band * bands.units_per_band;
+    int last_row = std::min(height, first_row + bands.units_per_band);
+    encoded[band].reserve(static_cast<size_t>(width) *
+                          (last_row - first_row));
+    EncodeQoiBand(rgba, width, stride, first_row, last_row, &encoded[band]);
+  });
+
+  std::vector<uint8_t> qoi = {'q', 'o', 'i', 'f'};
+  AppendBigEndian32(&qoi, width);
+  AppendBigEndian32(&qoi, height);
+  // 3 channels, sRGB.
+  qoi.push_back(3);
+  qoi.push_back(0);
+  for (const auto& band : encoded) {
+    qoi.insert(qoi.end(), band.begin(), band.end());
+  }
+  const uint8_t kEndMarker[] = {0, 0, 0, 0, 0, 0, 0, 1};
+  qoi.insert(qoi.end(), kEndMarker, kEndMarker + 8);
+  return qoi;
+}
+
+// JPEG: baseline, 4:2:0, the example tables of ITU T.81 Annex K.
+
+constexpr uint8_t kZigzag[64] = {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+constexpr uint8_t kLumaQuantization[64] = {
+    16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+    14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+    18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99};
+
+constexpr uint8_t kChromaQuantization[64] = {
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99};
+
+constexpr uint8_t kLumaDcBits[16] = {0, 1, 5, 1, 1, 1, 1, 1,
+                                     1, 0, 0, 0, 0, 0, 0, 0};
+constexpr uint8_t kChromaDcBits[16] = {0, 3, 1, 1, 1, 1, 1, 1,
+                                       1, 1, 1, 0, 0, 0, 0, 0};
+constexpr uint8_t kDcValues[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+constexpr uint8_t kLumaAcBits[16] = {0, 2, 1, 3, 3, 2, 4, 3,
+                                     5, 5, 4, 4, 0, 0, 1, 0x7d};
+constexpr uint8_t kLumaAcValues[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06,
+    0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08,
+    0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72,
+    0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45,
+    0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75,
+    0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3,
+    0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9,
+    0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4,
+    0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa};
+
+constexpr uint8_t kChromaAcBits[16] = {0, 2, 1, 2, 4, 4, 3, 4,
+                                       7, 5, 4, 4, 0, 1, 2, 0x77};
+constexpr uint8_t kChromaAcValues[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41,
+    0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91,
+    0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1,
+    0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44,
+    0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74,
+    0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a,
+    0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4,
+    0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4,
+    0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa};
+
+struct HuffmanTable {
+  uint16_t code[256] = {};
+  uint8_t size[256] = {};
+
+  HuffmanTable(const uint8_t* bits, const uint8_t* values) {
+    uint16_t next = 0;
+    int k = 0;
+    for (int length = 1; length <= 16; length++) {
+      for (int i = 0; i < bits[length - 1]; i++) {
+        code[values[k]] = next++;
+        size[values[k]] = static_cast<uint8_t>(length);
+        k++;
+      }
+      next <<= 1;
+    }
+  }
+};
+
+class JpegBitWriter {
+ public:
+  explicit JpegBitWriter(std::vector<uint8_t>* out) : out_(out) {}
+
+  void PutBits(uint32_t bits, int count) {
+    buffer_ = (buffer_ << count) | (bits & ((1u << count) - 1));
+    count_ += count;
+    while (count_ >= 8) {
+      uint8_t byte = static_cast<uint8_t>(buffer_ >> (count_ - 8));
+      out_->push_back(byte);
+      if (byte == 0xff) {
+        out_->push_back(0);
+      }
+      count_ -= 8;
+    }
+  }
+
+  // Pads the last byte with 1 bits.
+  void Flush() {
+    if (count_ > 0) {
+      PutBits(0x7f, 8 - count_);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>* out_;
+  uint64_t buffer_ = 0;
+  int count_ = 0;
+};
+
+// Scaled float DCT (Arai, Agui and Nakajima) of a block in place. The output
+// is scaled by the factors folded into the quantization divisors.
+void ForwardDct(float* block) {
+  for (int pass = 0; pass < 2; pass++) {
+    // Rows on the first pass, columns on the second.
+    int step = pass == 0 ? 1 : 8;
+    int advance = pass == 0 ? 8 : 1;
+    for (int i = 0; i < 8; i++) {
+      float* d = block + i * advance;
+      float tmp0 = d[0] + d[7 * step];
+      float tmp7 = d[0] - d[7 * step];
+      float tmp1 = d[step] + d[6 * step];
+      float tmp6 = d[step] - d[6 * step];
+      float tmp2 = d[2 * step] + d[5 * step];
+      float tmp5 = d[2 * step] - d[5 * step];
+      float tmp3 = d[3 * step] + d[4 * step];
+      float tmp4 = d[3 * step] - d[4 * step];
+
+      float tmp10 = tmp0 + tmp3;
+      float tmp13 = tmp0 - tmp3;
+      float tmp11 = tmp1 + tmp2;
+      float tmp12 = tmp1 - tmp2;
+      d[0] = tmp10 + tmp11;
+      d[4 * step] = tmp10 - tmp11;
+      float z1 = (tmp12 + tmp13) * 0.707106781f;
+      d[2 * step] = tmp13 + z1;
+      d[6 * step] = tmp13 - z1;
+
+      tmp10 = tmp4 + tmp5;
+      tmp11 = tmp5 + tmp6;
+      tmp12 = tmp6 + tmp7;
+      float z5 = (tmp10 - tmp12) * 0.382683433f;
+      float z2 = 0.541196100f * tmp10 + z5;
+      float z4 = 1.306562965f * tmp12 + z5;
+      float z3 = tmp11 * 0.707106781f;
+      float z11 = tmp7 + z3;
+      float z13 = tmp7 - z3;
+      d[5 * step] = z13 + z2;
+      d[3 * step] = z13 - z2;
+      d[step] = z11 + z4;
+      d[7 * step] = z11 - z4;
+    }
+  }
+}
+
+struct JpegTables {
+  uint8_t luma_quantization[64];
+  uint8_t chroma_quantization[64];
+  // Reciprocals of the quantizers with the DCT scale folded in.
+  float luma_divisors[64];
+  float chroma_divisors[64];
+
+  explicit JpegTables(int quality) {
+    static const float kAanScale[8] = {1.0f,         1.387039845f,
+                                       1.306562965f, 1.175875602f,
+                                       1.0f,         0.785694958f,
+                                       0.541196100f, 0.275899379f};
+    // The libjpeg quality scaling.
+    int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    for (int i = 0; i < 64; i++) {
+      luma_quantization[i] = static_cast<uint8_t>(
+          std::clamp((kLumaQuantization[i] * scale + 50) / 100, 1, 255));
+      chroma_quantization[i] = static_cast<uint8_t>(
+          std::clamp((kChromaQuantization[i] * scale + 50) / 100, 1, 255));
+      float aan = kAanScale[i / 8] * kAanScale[i % 8] * 8.0f;
+      luma_divisors[i] = 1.0f / (luma_quantization[i] * aan);
+      chroma_divisors[i] = 1.0f / (chroma_quantization[i] * aan);
+    }
+  }
+};
+
+void EncodeJpegBlock(float* block,
+                     const float* divisors,
+                     const HuffmanTable& dc,
+                     const HuffmanTable& ac,
+                     int* previous_dc,
+                     JpegBitWriter* writer) {
+  ForwardDct(block);
+  int coefficients[64];
+  for (int i = 0; i < 64; i++) {
+    int natural = kZigzag[i];
+    // Rounds to nearest without a call; the offset keeps the value positive.
+    coefficients[i] =
+        static_cast<int>(block[natural] * divisors[natural] + 16384.5f) -
+        16384;
+  }
+
+  auto put_value = [writer](const HuffmanTable& table, int symbol_high,
+                            int value) {
+    int magnitude = std::abs(value);
+    int category = magnitude ? FloorLog2(magnitude) + 1 : 0;
+    int symbol = symbol_high | category;
+    writer->PutBits(table.code[symbol], table.size[symbol]);
+    if (category) {
+      writer->PutBits(value < 0 ? value - 1 : value, category);
+    }
+  };
+
+  put_value(dc, 0, coefficients[0] - *previous_dc);
+  *previous_dc = coefficients[0];
+
+  int run = 0;
+  for (int i = 1; i < 64; i++) {
+    if (coefficients[i] == 0) {
+      run++;
+      continue;
+    }
+    while (run > 15) {
+      writer->PutBits(ac.code[0xf0], ac.size[0xf0]);
+      run -= 16;
+    }
+    put_value(ac, run << 4, coefficients[i]);
+    run = 0;
+  }
+  if (run > 0) {
+    writer->PutBits(ac.code[0x00], ac.size[0x00]);
+  }
+}
+
+// Encodes MCU rows [first_mcu_row, last_mcu_row) as one restart interval.
+void EncodeJpegBand(const uint8_t* rgba,
+                    int width,
+                    int height,
+                    int stride,
+                    int first_mcu_row,
+                    int last_mcu_row,
+                    const JpegTables& tables,
+                    std::vector<uint8_t>* out) {
+  static const HuffmanTable luma_dc(kLumaDcBits, kDcValues);
+  static const HuffmanTable chroma_dc(kChromaDcBits, kDcValues);
+  static const HuffmanTable luma_ac(kLumaAcBits, kLumaAcValues);
+  static const HuffmanTable chroma_ac(kChromaAcBits, kChromaAcValues);
+
+  JpegBitWriter writer(out);
+  int dc_y = 0;
+  int dc_cb = 0;
+  int dc_cr = 0;
+  float y[256];
+  float cb[256];
+  float cr[256];
+  float block[64];
+  int mcu_columns = (width + 15) / 16;
+  for (int mcu_y = first_mcu_row; mcu_y < last_mcu_row; mcu_y++) {
+    for (int mcu_x = 0; mcu_x < mcu_columns; mcu_x++) {
+      // Edge MCUs repeat the last row and column.
+      for (int row = 0; row < 16; row++) {
+        int image_y = std::min(mcu_y * 16 + row, height - 1);
+        const uint8_t* line = rgba + static_cast<size_t>(image_y) * stride;
+        for (int column = 0; column < 16; column++) {
+          int image_x = std::min(mcu_x * 16 + column, width - 1);
+          const uint8_t* pixel = line + 4 * image_x;
+          float r = pixel[0];
+          float g = pixel[1];
+          float b = pixel[2];
+          int i = row * 16 + column;
+          y[i] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+          cb[i] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+          cr[i] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+        }
+      }
+      for (int block_y = 0; block_y < 2; block_y++) {
+        for (int block_x = 0; block_x < 2; block_x++) {
+          for (int row = 0; row < 8; row++) {
+            memcpy(block + row * 8,
+                   y + (block_y * 8 + row) * 16 + block_x * 8,
+                   8 * sizeof(float));
+          }
+          EncodeJpegBlock(block, tables.luma_divisors, luma_dc, luma_ac,
+                          &dc_y, &writer);
+        }
+      }
+      for (float* plane : {cb, cr}) {
+        for (int row = 0; row < 8; row++) {
+          for (int column = 0; column < 8; column++) {
+            const float* p = plane + row * 32 + column * 2;
+            block[row * 8 + column] = (p[0] + p[1] + p[16] + p[17]) * 0.25f;
+          }
+        }
+        EncodeJpegBlock(block, tables.chroma_divisors, chroma_dc, chroma_ac,
+                        plane == cb ? &dc_cb : &dc_cr, &writer);
+      }
+    }
+  }
+  writer.Flush();
+}
+
+void AppendJpegMarker(std::vector<uint8_t>* out,
+                      uint8_t marker,
+                      const std::vector<uint8_t>& payload) {
+  out->push_back(0xff);
+  out->push_back(marker);
+  AppendBigEndian16(out, static_cast<uint16_t>(payload.size() + 2));
+  out->insert(out->end(), payload.begin(), payload.end());
+}
+
+void AppendHuffmanTable(std::vector<uint8_t>* payload,
+                        uint8_t table_class_and_id,
+                        const uint8_t* bits,
+                        const uint8_t* values) {
+  payload->push_back(table_class_and_id);
+  int count = 0;
+  for (int i = 0; i < 16; i++) {
+    payload->push_back(bits[i]);
+    count += bits[i];
+  }
+  payload->insert(payload->end(), values, values + count);
+}
+
+std::vector<uint8_t> EncodeJpeg(const uint8_t* rgba,
+                                int width,
+                                int height,
+                                int stride,
+                                int quality) {
+  JpegTables tables(std::clamp(quality, 1, 100));
+  int mcu_rows = (height + 15) / 16;
+  int mcu_columns = (width + 15) / 16;
+  Bands bands = SplitIntoBands(mcu_rows, kMinRowsPerBand / 16);
+  // The restart interval is a 16-bit MCU count.
+  if (bands.units_per_band * mcu_columns > 0xffff) {
+    bands.units_per_band = std::max(1, 0xffff / mcu_columns);
+    bands.count =
+        (mcu_rows + bands.units_per_band - 1) / bands.units_per_band;
+  }
+
+  std::vector<std::vector<uint8_t>> encoded(bands.count);
+  ForEachBand(bands.count, [&](int band) {
+    int first = band * bands.units_per_band;
+    int last = std::min(mcu_rows, first + bands.units_per_band);
+    EncodeJpegBand(rgba, width, height, stride, first, last, tables,
+                   &encoded[band]);
+  });
+
+  std::vector<uint8_t> jpeg = {0xff, 0xd8};
+  AppendJpegMarker(&jpeg, 0xe0,
+                   {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0});
+
+  std::vector<uint8_t> quantization;
+  quantization.push_back(0);
+  for (int i = 0; i < 64; i++) {
+    quantization.push_back(tables.luma_quantization[kZigzag[i]]);
+  }
+  quantization.push_back(1);
+  for (int i = 0; i < 64; i++) {
+    quantization.push_back(tables.chroma_quantization[kZigzag[i]]);
+  }
+  AppendJpegMarker(&jpeg, 0xdb, quantization);
+
+  std::vector<uint8_t> frame = {8};
+  AppendBigEndian16(&frame, static_cast<uint16_t>(height));
+  AppendBigEndian16(&frame, static_cast<uint16_t>(width));
+  // Y sampled 2x2 with table 0, Cb and Cr 1x1 with table 1.
+  const uint8_t kComponents[] = {3, 1, 0x22, 0, 2, 0x11, 1, 3, 0x11, 1};
+  frame.insert(frame.end(), kComponents, kComponents + 10);
+  AppendJpegMarker(&jpeg, 0xc0, frame);
+
+  std::vector<uint8_t> huffman;
+  AppendHuffmanTable(&huffman, 0x00, kLumaDcBits, kDcValues);
+  AppendHuffmanTable(&huffman, 0x10, kLumaAcBits, kLumaAcValues);
+  AppendHuffmanTable(&huffman, 0x01, kChromaDcBits, kDcValues);
+  AppendHuffmanTable(&huffman, 0x11, kChromaAcBits, kChromaAcValues);
+  AppendJpegMarker(&jpeg, 0xc4, huffman);
+
+  if (bands.count > 1) {
+    std::vector<uint8_t> restart_interval;
+    AppendBigEndian16(&restart_interval, static_cast<uint16_t>(
+                                             bands.units_per_band *
+                                             mcu_columns));
+    AppendJpegMarker(&jpeg, 0xdd, restart_interval);
+  }
+
+  AppendJpegMarker(&jpeg, 0xda,
+                   {3, 1, 0x00, 2, 0x11, 3, 0x11, 0, 63, 0});
+  for (int band = 0; band < bands.count; band++) {
+    if (band > 0) {
+      jpeg.push_back(0xff);
+      jpeg.push_back(static_cast<uint8_t>(0xd0 + (band - 1) % 8));
+    }
+    jpeg.insert(jpeg.end(), encoded[band].begin(), encoded[band].end());
+  }
+  jpeg.push_back(0xff);
+  jpeg.push_back(0xd9);
+  return jpeg;
+}
+
+}  // namespace
+
+bool ParseImageFormat(const std::string& name, ImageFormat* format) {
+  if (name == "png") {
+    *format = ImageFormat::kPNG;
+  } else if (name == "jpeg" || name == "jpg") {
+    *format = ImageFormat::kJPEG;
+  } else if (name == "qoi") {
+    *format = ImageFormat::kQOI;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> EncodeImage(const uint8_t* rgba,
+                                 int width,
+                                 int height,
+                                 int stride,
+                                 ImageFormat format,
+                                 int quality) {
+  if (width <= 0 || height <= 0) {
+    return {};
+  }
+  switch (format) {
+    case ImageFormat::kPNG:
+      return EncodePng(rgba, width, height, stride);
+    case ImageFormat::kJPEG:
+      return EncodeJpeg(rgba, width, height, stride, quality);
+    case ImageFormat::kQOI:
+      return EncodeQoi(rgba, width, height, stride);
+  }
+  return {};
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -0,0 +1,521 @@
+#ifdef _MSC_VER
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "flutter_media_recorder.h"
+#include "flutter_video_frame_converter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+void CopyPlane(const uint8_t* src,
+               int src_stride,
+               int width,
+               int height,
+               uint8_t* dst) {
+  for (int y = 0; y < height; y++) {
+    memcpy(dst + static_cast<size_t>(y) * width,
+           src + static_cast<size_t>(y) * src_stride, width);
+  }
+}
+
+void PutLittleEndian(uint8_t* dst, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    dst[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+// Where the extension of the file name in |path| starts, or its length.
+size_t ExtensionStart(const std::string& path) {
+  size_t dot = path.find_last_of('.');
+  size_t separator = path.find_last_of("/\\");
+  if (dot == std::string::npos ||
+      (separator != std::string::npos && dot < separator)) {
+    return path.size();
+  }
+  return dot;
+}
+
+std::string ReplaceExtension(const std::string& path,
+                             const std::string& extension) {
+  return path.substr(0, ExtensionStart(path)) + extension;
+}
+
+}  // namespace
+
+VideoFrameQueue::VideoFrameQueue(size_t capacity) : slots_(capacity) {}
+
+bool VideoFrameQueue::Push(RTCVideoFrame* frame, int64_t timestamp_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ == slots_.size()) {
+    return false;
+  }
+  Frame& slot = slots_[(head_ + count_) % slots_.size()];
+  YuvPlanes src = YuvPlanesFromFrame(frame);
+  int chroma_width = (src.width + 1) / 2;
+  int chroma_height = (src.height + 1) / 2;
+  size_t luma_size = static_cast<size_t>(src.width) * src.height;
+  size_t chroma_size = static_cast<size_t>(chroma_width) * chroma_height;
+  slot.data.resize(luma_size + 2 * chroma_size);
+  slot.width = src.width;
+  slot.height = src.height;
+  slot.rotation = static_cast<int>(frame->rotation());
+  slot.timestamp_us = timestamp_us;
+
+  uint8_t* y = slot.data.data();
+  CopyPlane(src.y, src.stride_y, src.width, src.height, y);
+  CopyPlane(src.u, src.stride_u, chroma_width, chroma_height, y + luma_size);
+  CopyPlane(src.v, src.stride_v, chroma_width, chroma_height,
+            y + luma_size + chroma_size);
+  count_++;
+  return true;
+}
+
+const VideoFrameQueue::Frame* VideoFrameQueue::Front() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_ > 0 ? &slots_[head_] : nullptr;
+}
+
+void VideoFrameQueue::Pop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ > 0) {
+    head_ = (head_ + 1) % slots_.size();
+    count_--;
+  }
+}
+
+Y4mWriter::~Y4mWriter() {
+  Close();
+}
+
+bool Y4mWriter::Open(const std::string& path) {
+  path_ = path;
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    return false;
+  }
+  segments_.push_back(path);
+  return true;
+}
+
+bool Y4mWriter::StartSegment(int width, int height, int fps) {
+  if (!file_) {
+    return false;
+  }
+  if (width_ != 0) {
+    size_t extension = ExtensionStart(path_);
+    std::string path = path_.substr(0, extension) + "." +
+                       std::to_string(segments_.size()) +
+                       path_.substr(extension);
+    bool closed = fclose(file_) == 0;
+    file_ = closed ? fopen(path.c_str(), "wb") : nullptr;
+    if (!file_) {
+      return false;
+    }
+    segments_.push_back(path);
+  }
+  width_ = width;
+  height_ = height;
+  return fprintf(file_, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width,
+                 height, fps) > 0;
+}
+
+bool Y4mWriter::WriteFrame(const uint8_t* i420, size_t size) {
+  return file_ && fputs("FRAME\n", file_) >= 0 &&
+         fwrite(i420, 1, size, file_) == size;
+}
+
+bool Y4mWriter::Close() {
+  if (!file_) {
+    return true;
+  }
+  bool closed = fclose(file_) == 0;
+  file_ = nullptr;
+  return closed;
+}
+
+WavWriter::~WavWriter() {
+  Close();
+}
+
+bool WavWriter::Open(const std::string& path) {
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    return false;
+  }
+  data_bytes_ = 0;
+  uint8_t header[44] = {};
+  return fwrite(header, 1, sizeof(header), file_) == sizeof(header);
+}
+
+void WavWriter::SetFormat(int sample_rate, int channels) {
+  sample_rate_ = sample_rate;
+  channels_ = channels;
+}
+
+bool WavWriter::Write(const int16_t* samples, size_t count) {
+  if (!file_) {
+    return false;
+  }
+  // WAV is little-endian, like every platform this plugin builds for.
+  size_t written = fwrite(samples, sizeof(int16_t), count, file_);
+  data_bytes_ += static_cast<uint32_t>(written * sizeof(int16_t));
+  return written == count;
+}
+
+bool WavWriter::Close() {
+  if (!file_) {
+    return true;
+  }
+  uint8_t header[44] = {'R', 'I', 'F', 'F', 0,   0,   0,   0,   'W',
+                        'A', 'V', 'E', 'f', 'm', 't', ' ', 16,  0,
+                        0,   0,   1,   0,   0,   0,   0,   0,   0,
+                        0,   0,   0,   0,   0,   0,   0,   16,  0,
+                        'd', 'a', 't', 'a', 0,   0,   0,   0};
+  PutLittleEndian(header + 4, 36 + data_bytes_, 4);
+  PutLittleEndian(header + 22, channels_, 2);
+  PutLittleEndian(header + 24, sample_rate_, 4);
+  PutLittleEndian(header + 28, sample_rate_ * channels_ * 2, 4);
+  PutLittleEndian(header + 32, channels_ * 2, 2);
+  PutLittleEndian(header + 40, data_bytes_, 4);
+  bool ok = fseek(file_, 0, SEEK_SET) == 0 &&
+            fwrite(header, 1, sizeof(header), file_) == sizeof(header);
+  ok = fclose(file_) == 0 && ok;
+  file_ = nullptr;
+  return ok;
+}
+
+constexpr int FlutterMediaRecorder::kFrameRate;
+
+FlutterMediaRecorder::FlutterMediaRecorder(
+    scoped_refptr<RTCVideoTrack> video_track,
+    std::string video_path,
+    scoped_refptr<RTCAudioTrack> audio_track,
+    std::string audio_path)
+    : video_track_(video_track),
+      video_path_(video_path),
+      audio_track_(audio_track),
+      audio_path_(audio_path) {}
+
+FlutterMediaRecorder::~FlutterMediaRecorder() {
+  if (writer_.joinable()) {
+    Stop();
+  }
+}
+
+bool FlutterMediaRecorder::Start() {
+  bool video_opened = video_track_ && y4m_.Open(video_path_);
+  bool audio_opened = audio_track_ && wav_.Open(audio_path_);
+  if ((video_track_ && !video_opened) || (audio_track_ && !audio_opened)) {
+    y4m_.Close();
+    wav_.Close();
+    if (video_opened) {
+      remove(video_path_.c_str());
+    }
+    if (audio_opened) {
+      remove(audio_path_.c_str());
+    }
+    return false;
+  }
+  if (video_track_) {
+    video_queue_ = std::make_unique<VideoFrameQueue>(kVideoQueueFrames);
+  }
+  start_time_ = std::chrono::steady_clock::now();
+  writer_ = std::thread([this] { WriterLoop(); });
+  if (video_track_) {
+    video_track_->AddRenderer(this);
+  }
+  if (audio_track_) {
+    audio_track_->AddSink(this);
+  }
+  return true;
+}
+
+bool FlutterMediaRecorder::Stop() {
+  if (video_track_) {
+    video_track_->RemoveRenderer(this);
+  }
+  if (audio_track_) {
+    audio_track_->RemoveSink(this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  bool closed = y4m_.Close();
+  closed = wav_.Close() && closed;
+  return closed && !failed_;
+}
+
+void FlutterMediaRecorder::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  int64_t timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start_time_)
+                             .count();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+      return;
+    }
+  }
+  bool queued = video_queue_->Push(frame.get(), timestamp_us);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!queued) {
+      video_frames_dropped_++;
+      return;
+    }
+    work_pending_ = true;
+  }
+  wake_.notify_one();
+}
+
+void FlutterMediaRecorder::OnData(const void* audio_data,
+                                  int bits_per_sample,
+                                  int sample_rate,
+                                  size_t number_of_channels,
+                                  size_t number_of_frames) {
+  size_t count = number_of_channels * number_of_frames;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+      return;
+    }
+    if (audio_ring_.empty()) {
+      audio_sample_rate_ = sample_rate;
+      audio_channels_ = static_cast<int>(number_of_channels);
+      audio_ring_.resize(static_cast<size_t>(sample_rate) *
+                         number_of_channels * kAudioQueueMs / 1000);
+    }
+    // The WAV format is fixed by the first chunk.
+    if (bits_per_sample != 16 || sample_rate != audio_sample_rate_ ||
+        static_cast<int>(number_of_channels) != audio_channels_ ||
+        audio_count_ + count > audio_ring_.size()) {
+      audio_chunks_dropped_++;
+      return;
+    }
+    const int16_t* samples = static_cast<const int16_t*>(audio_data);
+    size_t tail = (audio_head_ + audio_count_) % audio_ring_.size();
+    size_t first = std::min(count, audio_ring_.size() - tail);
+    std::copy(samples, samples + first, audio_ring_.begin() + tail);
+    std::copy(samples + first, samples + count, audio_ring_.begin());
+    audio_count_ += count;
+    work_pending_ = true;
+  }
+  wake_.notify_one();
+}
+
+void FlutterMediaRecorder::WriterLoop() {
+  while (true) {
+    bool stopping;
+    bool failed;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return stopping_ || work_pending_; });
+      work_pending_ = false;
+      stopping = stopping_;
+      failed = failed_;
+    }
+    if (!failed) {
+      bool ok = DrainVideo();
+      ok = DrainAudio() && ok;
+      if (!ok) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_ = true;
+      }
+    }
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+bool FlutterMediaRecorder::DrainVideo() {
+  if (!video_queue_) {
+    return true;
+  }
+  while (const VideoFrameQueue::Frame* frame = video_queue_->Front()) {
+    if (frame->width != y4m_.width() || frame->height != y4m_.height()) {
+      if (!y4m_.StartSegment(frame->width, frame->height, kFrameRate)) {
+        return false;
+      }
+      first_video_us_ = frame->timestamp_us;
+      frames_written_ = 0;
+    }
+    // Index of the output frame this one lands on, relative to the first of
+    // its segment.
+    int64_t index = ((frame->timestamp_us - first_video_us_) * kFrameRate +
+                     500000) /
+                    1000000;
+    for (; frames_written_ <= index; frames_written_++) {
+      if (!y4m_.WriteFrame(frame->data.data(), frame->data.size())) {
+        return false;
+      }
+    }
+    video_queue_->Pop();
+  }
+  return true;
+}
+
+bool FlutterMediaRecorder::DrainAudio() {
+  int sample_rate;
+  int channels;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (audio_count_ == 0) {
+      return true;
+    }
+    size_t first = std::min(audio_count_, audio_ring_.size() - audio_head_);
+    audio_scratch_.assign(audio_ring_.begin() + audio_head_,
+                          audio_ring_.begin() + audio_head_ + first);
+    audio_scratch_.insert(audio_scratch_.end(), audio_ring_.begin(),
+                          audio_ring_.begin() + (audio_count_ - first));
+    audio_head_ = (audio_head_ + audio_count_) % audio_ring_.size();
+    audio_count_ = 0;
+    sample_rate = audio_sample_rate_;
+    channels = audio_channels_;
+  }
+  wav_.SetFormat(sample_rate, channels);
+  return wav_.Write(audio_scratch_.data(), audio_scratch_.size());
+}
+
+FlutterMediaRecorderManager::FlutterMediaRecorderManager(
+    FlutterWebRTCBase* base)
+    : base_(base) {}
+
+FlutterMediaRecorderManager::~FlutterMediaRecorderManager() {
+  for (auto& recording : recorders_) {
+    recording.second.recorder->Stop();
+  }
+}
+
+void FlutterMediaRecorderManager::StartRecordToFile(
+    const EncodableMap& params,
+    std::unique_ptr<MethodResultProxy> result) {
+  int64_t recorder_id = findLongInt(params, "recorderId");
+  std::string path = findString(params, "path");
+  if (path.empty()) {
+    result->Error("startRecordToFile", "startRecordToFile() path is empty");
+    return;
+  }
+  if (recorders_.find(recorder_id) != recorders_.end()) {
+    result->Error("startRecordToFile",
+                  "startRecordToFile() recorder already started");
+    return;
+  }
+
+  scoped_refptr<RTCVideoTrack> video_track;
+  std::string video_track_id = findString(params, "videoTrackId");
+  if (!video_track_id.empty()) {
+    scoped_refptr<RTCMediaTrack> track =
+        base_->MediaTrackForId(video_track_id);
+    if (!track || track->kind().std_string() != "video") {
+      result->Error("startRecordToFile",
+                    "startRecordToFile() video track not found");
+      return;
+    }
+    video_track = static_cast<RTCVideoTrack*>(track.get());
+  }
+
+  scoped_refptr<RTCAudioTrack> audio_track;
+  int audio_channel = findInt(params, "audioChannel");
+  if (audio_channel >= 0) {
+    audio_track =
+        FindAudioTrack(audio_channel, findString(params, "peerConnectionId"));
+    if (!audio_track) {
+      result->Error("startRecordToFile",
+                    "startRecordToFile() audio track not found");
+      return;
+    }
+  }
+  if (!video_track && !audio_track) {
+    result->Error("startRecordToFile",
+                  "startRecordToFile() no track to record");
+    return;
+  }
+
+  Recording recording;
+  recording.video_path = video_track ? path : "";
+  recording.audio_path =
+      audio_track ? (video_track ? ReplaceExtension(path, ".wav") : path) : "";
+  recording.recorder = std::make_unique<FlutterMediaRecorder>(
+      video_track, recording.video_path, audio_track, recording.audio_path);
+  if (!recording.recorder->Start()) {
+    result->Error("startRecordToFile",
+                  "startRecordToFile() could not create the output files");
+    return;
+  }
+  recorders_[recorder_id] = std::move(recording);
+  result->Success();
+}
+
+void FlutterMediaRecorderManager::StopRecordToFile(
+    int64_t recorder_id,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = recorders_.find(recorder_id);
+  if (it == recorders_.end()) {
+    result->Error("stopRecordToFile", "stopRecordToFile() recorder not found");
+    return;
+  }
+  Recording recording = std::move(it->second);
+  recorders_.erase(it);
+  if (!recording.recorder->Stop()) {
+    result->Error("stopRecordToFile",
+                  "stopRecordToFile() failed to write the recording");
+    return;
+  }
+
+  EncodableMap params;
+  if (!recording.video_path.empty()) {
+    params[EncodableValue("video")] = EncodableValue(recording.video_path);
+    EncodableList segments;
+    for (const std::string& segment : recording.recorder->video_segments()) {
+      segments.push_back(EncodableValue(segment));
+    }
+    params[EncodableValue("videoSegments")] = EncodableValue(segments);
+  }
+  if (!recording.audio_path.empty()) {
+    params[EncodableValue("audio")] = EncodableValue(recording.audio_path);
+  }
+  params[EncodableValue("videoFramesDropped")] = EncodableValue(
+      static_cast<int64_t>(recording.recorder->video_frames_dropped()));
+  params[EncodableValue("audioChunksDropped")] = EncodableValue(
+      static_cast<int64_t>(recording.recorder->audio_chunks_dropped()));
+  result->Success(EncodableValue(params));
+}
+
+scoped_refptr<RTCAudioTrack> FlutterMediaRecorderManager::FindAudioTrack(
+    int audio_channel,
+    const std::string& peer_connection_id) {
+  // RecorderAudioChannel.INPUT: the first local (microphone) audio track.
+  if (audio_channel == 0) {
+    for (auto& track : base_->local_tracks_) {
+      if (track.second->kind().std_string() == "audio") {
+        return static_cast<RTCAudioTrack*>(track.second.get());
+      }
+    }
+    return nullptr;
+  }
+  // RecorderAudioChannel.OUTPUT: the first remote audio track.
+  RTCPeerConnection* pc = base_->PeerConnectionForId(peer_connection_id);
+  if (!pc) {
+    return nullptr;
+  }
+  auto receivers = pc->receivers();
+  for (scoped_refptr<RTCRtpReceiver> receiver : receivers.std_vector()) {
+    scoped_refptr<RTCMediaTrack> track = receiver->track();
+    if (track && track->kind().std_string() == "audio") {
+      return static_cast<RTCAudioTrack*>(track.get());
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -50,7 +50,7 @@ void FlutterMediaStream::GetUserMedia(
 
   auto it = constraints.find(EncodableValue("audio"));
   if (it != constraints.end()) {
-    EncodableValue audio = it->second;
+    const EncodableValue& audio = it->second;
     if (TypeIs<bool>(audio)) {
       if (true == GetValue<bool>(audio)) {
         GetUserAudio(constraints, stream, params);
@@ -67,7 +67,7 @@ void FlutterMediaStream::GetUserMedia(
   it = constraints.find(EncodableValue("video"));
   params[EncodableValue("videoTracks")] = EncodableValue(EncodableList());
   if (it != constraints.end()) {
-    EncodableValue video = it->second;
+    const EncodableValue& video = it->second;
     if (TypeIs<bool>(video)) {
       if (true == GetValue<bool>(video)) {
         GetUserVideo(constraints, stream, params);
@@ -148,10 +148,10 @@ static bool getAudioProcessingFlag(const EncodableMap& audioMap,
 std::string getSourceIdConstraint(const EncodableMap& mediaConstraints) {
   auto it = mediaConstraints.find(EncodableValue("optional"));
   if (it != mediaConstraints.end() && TypeIs<EncodableList>(it->second)) {
-    EncodableList optional = GetValue<EncodableList>(it->second);
+    const EncodableList& optional = GetValue<EncodableList>(it->second);
     for (size_t i = 0, size = optional.size(); i < size; i++) {
       if (TypeIs<EncodableMap>(optional[i])) {
-        EncodableMap option = GetValue<EncodableMap>(optional[i]);
+        const EncodableMap& option = GetValue<EncodableMap>(optional[i]);
         auto it2 = option.find(EncodableValue("sourceId"));
         if (it2 != option.end() && TypeIs<std::string>(it2->second)) {
           return GetValue<std::string>(it2->second);
@@ -180,7 +180,7 @@ void FlutterMediaStream::GetUserAudio(const EncodableMap& constraints,
   std::string deviceId;
   auto it = constraints.find(EncodableValue("audio"));
   if (it != constraints.end()) {
-    EncodableValue audio = it->second;
+    const EncodableValue& audio = it->second;
     if (TypeIs<bool>(audio)) {
       audioConstraints = RTCMediaConstraints::Create();
       addDefaultAudioConstraints(audioConstraints);
@@ -194,7 +194,7 @@ void FlutterMediaStream::GetUserAudio(const EncodableMap& constraints,
       audio_options.highpass_filter = false;
     }
     if (TypeIs<EncodableMap>(audio)) {
-      EncodableMap localMap = GetValue<EncodableMap>(audio);
+      const EncodableMap& localMap = GetValue<EncodableMap>(audio);
       sourceId = getSourceIdConstraint(localMap);
       deviceId = getDeviceIdConstraint(localMap);
       audioConstraints = base_->ParseMediaConstraints(localMap);
@@ -310,7 +310,7 @@ EncodableValue getConstrainInt(const EncodableMap& constraints,
     }
 
     if (TypeIs<EncodableMap>(it->second)) {
-      EncodableMap innerMap = GetValue<EncodableMap>(it->second);
+      const EncodableMap& innerMap = GetValue<EncodableMap>(it->second);
       auto it2 = innerMap.find(EncodableValue("ideal"));
       if (it2 != innerMap.end() && TypeIs<int>(it2->second)) {
         return it2->second;
@@ -0,0 +1,234 @@
+#include "flutter_method_dispatcher.h"
+
+#include <mutex>
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// Records the time from dispatch until the first result is reported.
+class TimedMethodResult : public MethodResultProxy {
+ public:
+  TimedMethodResult(std::unique_ptr<MethodResultProxy> result,
+                    LatencyHistogram* histogram,
+                    std::chrono::steady_clock::time_point start)
+      : result_(std::move(result)), histogram_(histogram), start_(start) {}
+
+  void Success() override {
+    Record();
+    result_->Success();
+  }
+
+  void Success(const EncodableValue& result) override {
+    Record();
+    result_->Success(result);
+  }
+
+  void Error(const std::string& error_code,
+             const std::string& error_message,
+             const EncodableValue& error_details) override {
+    Record();
+    result_->Error(error_code, error_message, error_details);
+  }
+
+  void Error(const std::string& error_code,
+             const std::string& error_message) override {
+    Record();
+    result_->Error(error_code, error_message);
+  }
+
+  void NotImplemented() override {
+    Record();
+    result_->NotImplemented();
+  }
+
+ private:
+  void Record() {
+    if (!recorded_) {
+      recorded_ = true;
+      histogram_->Record(std::chrono::steady_clock::now() - start_);
+    }
+  }
+
+  std::unique_ptr<MethodResultProxy> result_;
+  LatencyHistogram* histogram_;
+  std::chrono::steady_clock::time_point start_;
+  bool recorded_ = false;
+};
+
+// A call unpacked from a batch, borrowing its name and arguments.
+class BatchMethodCall : public MethodCallProxy {
+ public:
+  BatchMethodCall(const std::string& method_name,
+                  const EncodableValue* arguments)
+      : method_name_(method_name), arguments_(arguments) {}
+
+  const std::string& method_name() const override { return method_name_; }
+
+  const EncodableValue* arguments() const override { return arguments_; }
+
+ private:
+  const std::string& method_name_;
+  const EncodableValue* arguments_;
+};
+
+// Collects the replies of a batch, in call order, and sends them as one
+// list once the last one is in. Replies may come from any thread.
+class BatchReplies {
+ public:
+  BatchReplies(size_t count, std::unique_ptr<MethodResultProxy> result)
+      : replies_(count), pending_(count), result_(std::move(result)) {}
+
+  void Set(size_t index, EncodableMap reply) {
+    std::unique_ptr<MethodResultProxy> result;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      replies_[index] = EncodableValue(std::move(reply));
+      if (--pending_ == 0) {
+        result = std::move(result_);
+      }
+    }
+    if (result) {
+      result->Success(EncodableValue(std::move(replies_)));
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  EncodableList replies_;
+  size_t pending_;
+  std::unique_ptr<MethodResultProxy> result_;
+};
+
+// Reports the reply of one call of a batch. A handler that drops its result
+// without replying still completes the batch, with an error for that call.
+class BatchMethodResult : public MethodResultProxy {
+ public:
+  BatchMethodResult(std::shared_ptr<BatchReplies> replies, size_t index)
+      : replies_(std::move(replies)), index_(index) {}
+
+  ~BatchMethodResult() {
+    Error("noReply", "The method dropped its result without replying");
+  }
+
+  void Success() override { Success(EncodableValue()); }
+
+  void Success(const EncodableValue& result) override {
+    EncodableMap reply;
+    reply[EncodableValue("result")] = result;
+    Reply(std::move(reply));
+  }
+
+  void Error(const std::string& error_code,
+             const std::string& error_message,
+             const EncodableValue& error_details) override {
+    EncodableMap reply;
+    reply[EncodableValue("error")] = EncodableValue(error_code);
+    reply[EncodableValue("message")] = EncodableValue(error_message);
+    reply[EncodableValue("details")] = error_details;
+    Reply(std::move(reply));
+  }
+
+  void Error(const std::string& error_code,
+             const std::string& error_message) override {
+    Error(error_code, error_message, EncodableValue());
+  }
+
+  void NotImplemented() override {
+    Error("notImplemented", "Method not implemented");
+  }
+
+ private:
+  void Reply(EncodableMap reply) {
+    if (!replied_) {
+      replied_ = true;
+      replies_->Set(index_, std::move(reply));
+    }
+  }
+
+  std::shared_ptr<BatchReplies> replies_;
+  size_t index_;
+  bool replied_ = false;
+};
+
+}  // namespace
+
+void FlutterMethodDispatcher::Register(const std::string& method,
+                                       MethodHandler handler) {
+  methods_[method].handler = std::move(handler);
+}
+
+void FlutterMethodDispatcher::RegisterWithParams(const std::string& method,
+                                                 ParamsHandler handler) {
+  Register(method, [handler](const MethodCallProxy& method_call,
+                             std::unique_ptr<MethodResultProxy> result) {
+    if (!method_call.arguments()) {
+      result->Error("Bad Arguments", "Null arguments received");
+      return;
+    }
+    const EncodableMap& params =
+        GetValue<EncodableMap>(*method_call.arguments());
+    handler(params, std::move(result));
+  });
+}
+
+void FlutterMethodDispatcher::Dispatch(
+    const MethodCallProxy& method_call,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = methods_.find(method_call.method_name());
+  if (it == methods_.end()) {
+    result->NotImplemented();
+    return;
+  }
+  Method& method = it->second;
+  auto start = std::chrono::steady_clock::now();
+  method.handler(method_call,
+                 std::make_unique<TimedMethodResult>(
+                     std::move(result), &method.reply_time, start));
+  method.handler_time.Record(std::chrono::steady_clock::now() - start);
+}
+
+void FlutterMethodDispatcher::DispatchBatch(
+    const EncodableList& calls,
+    std::unique_ptr<MethodResultProxy> result) {
+  if (calls.empty()) {
+    result->Success(EncodableValue(EncodableList()));
+    return;
+  }
+  auto replies =
+      std::make_shared<BatchReplies>(calls.size(), std::move(result));
+  for (size_t i = 0; i < calls.size(); i++) {
+    auto entry_result = std::make_unique<BatchMethodResult>(replies, i);
+    if (!TypeIs<EncodableMap>(calls[i])) {
+      entry_result->Error("Bad Arguments", "Batch entry is not a map");
+      continue;
+    }
+    const EncodableMap& entry = GetValue<EncodableMap>(calls[i]);
+    const std::string& method = findString(entry, "method");
+    if (method.empty()) {
+      entry_result->Error("Bad Arguments", "Batch entry has no method");
+      continue;
+    }
+    const EncodableValue& args = findEncodableValue(entry, "args");
+    Dispatch(BatchMethodCall(method, args.IsNull() ? nullptr : &args),
+             std::move(entry_result));
+  }
+}
+
+EncodableMap FlutterMethodDispatcher::MethodStats() const {
+  EncodableMap stats;
+  for (const auto& entry : methods_) {
+    const Method& method = entry.second;
+    if (method.handler_time.count() == 0) {
+      continue;
+    }
+    EncodableMap times;
+    times[EncodableValue("handler")] =
+        EncodableValue(method.handler_time.ToMap());
+    times[EncodableValue("reply")] = EncodableValue(method.reply_time.ToMap());
+    stats[EncodableValue(entry.first)] = EncodableValue(times);
+  }
+  return stats;
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -2,6 +2,7 @@
 
 #include "base/scoped_ref_ptr.h"
 #include "flutter_data_channel.h"
+#include "flutter_event_builder.h"
 #include "flutter_frame_capturer.h"
 #include "rtc_dtmf_sender.h"
 #include "rtc_rtp_parameters.h"
@@ -513,21 +514,22 @@ void FlutterPeerConnection::GetRemoteDescription(
 
 scoped_refptr<RTCRtpTransceiverInit>
 FlutterPeerConnection::mapToRtpTransceiverInit(const EncodableMap& params) {
-  EncodableList streamIds = findList(params, "streamIds");
+  const EncodableList& streamIds = findList(params, keys::kStreamIds);
 
   std::vector<string> stream_ids;
-  for (auto item : streamIds) {
-    std::string id = GetValue<std::string>(item);
+  for (const auto& item : streamIds) {
+    const std::string& id = GetValue<std::string>(item);
     stream_ids.push_back(id.c_str());
   }
   RTCRtpTransceiverDirection dir = RTCRtpTransceiverDirection::kInactive;
-  EncodableValue direction = findEncodableValue(params, "direction");
+  const EncodableValue& direction =
+      findEncodableValue(params, keys::kDirection);
   if (!direction.IsNull()) {
     dir = stringToTransceiverDirection(GetValue<std::string>(direction));
   }
-  EncodableList sendEncodings = findList(params, "sendEncodings");
+  const EncodableList& sendEncodings = findList(params, keys::kSendEncodings);
   std::vector<scoped_refptr<RTCRtpEncodingParameters>> encodings;
-  for (EncodableValue value : sendEncodings) {
+  for (const EncodableValue& value : sendEncodings) {
     encodings.push_back(mapToEncoding(GetValue<EncodableMap>(value)));
   }
   scoped_refptr<RTCRtpTransceiverInit> init =
@@ -561,60 +563,60 @@ FlutterPeerConnection::mapToEncoding(const EncodableMap& params) {
   encoding->set_bitrate_priority(1.0);
   encoding->set_network_priority(libwebrtc::RTCPriority::kLow);
 
-  EncodableValue value = findEncodableValue(params, "active");
-  if (!value.IsNull()) {
-    encoding->set_active(GetValue<bool>(value));
+  const EncodableValue* value = &findEncodableValue(params, keys::kActive);
+  if (!value->IsNull()) {
+    encoding->set_active(GetValue<bool>(*value));
   }
 
-  value = findEncodableValue(params, "rid");
-  if (!value.IsNull()) {
-    const std::string rid = GetValue<std::string>(value);
+  value = &findEncodableValue(params, keys::kRid);
+  if (!value->IsNull()) {
+    const std::string rid = GetValue<std::string>(*value);
     encoding->set_rid(rid.c_str());
   }
 
-  value = findEncodableValue(params, "ssrc");
-  if (!value.IsNull()) {
-    encoding->set_ssrc((uint32_t)GetValue<int>(value));
+  value = &findEncodableValue(params, keys::kSsrc);
+  if (!value->IsNull()) {
+    encoding->set_ssrc((uint32_t)GetValue<int>(*value));
   }
 
-  value = findEncodableValue(params, "minBitrate");
-  if (!value.IsNull()) {
-    encoding->set_min_bitrate_bps(GetValue<int>(value));
+  value = &findEncodableValue(params, keys::kMinBitrate);
+  if (!value->IsNull()) {
+    encoding->set_min_bitrate_bps(GetValue<int>(*value));
   }
 
-  value = findEncodableValue(params, "maxBitrate");
-  if (!value.IsNull()) {
-    encoding->set_max_bitrate_bps(GetValue<int>(value));
+  value = &findEncodableValue(params, keys::kMaxBitrate);
+  if (!value->IsNull()) {
+    encoding->set_max_bitrate_bps(GetValue<int>(*value));
   }
 
-  value = findEncodableValue(params, "maxFramerate");
-  if (!value.IsNull()) {
-    encoding->set_max_framerate(GetValue<int>(value));
+  value = &findEncodableValue(params, keys::kMaxFramerate);
+  if (!value->IsNull()) {
+    encoding->set_max_framerate(GetValue<int>(*value));
   }
 
-  value = findEncodableValue(params, "numTemporalLayers");
-  if (!value.IsNull()) {
-    encoding->set_num_temporal_layers(GetValue<int>(value));
+  value = &findEncodableValue(params, keys::kNumTemporalLayers);
+  if (!value->IsNull()) {
+    encoding->set_num_temporal_layers(GetValue<int>(*value));
   }
 
-  value = findEncodableValue(params, "scaleResolutionDownBy");
-  if (!value.IsNull()) {
-    encoding->set_scale_resolution_down_by(GetValue<double>(value));
+  value = &findEncodableValue(params, keys::kScaleResolutionDownBy);
+  if (!value->IsNull()) {
+    encoding->set_scale_resolution_down_by(GetValue<double>(*value));
   }
 
-  value = findEncodableValue(params, "scalabilityMode");
-  if (!value.IsNull()) {
-    encoding->set_scalability_mode(GetValue<std::string>(value));
+  value = &findEncodableValue(params, keys::kScalabilityMode);
+  if (!value->IsNull()) {
+    encoding->set_scalability_mode(GetValue<std::string>(*value));
   }
 
-  value = findEncodableValue(params, "priority");
-  if (!value.IsNull()) {
-    encoding->set_bitrate_priority(stringToBitratePriority(GetValue<std::string>(value)));
+  value = &findEncodableValue(params, keys::kPriority);
+  if (!value->IsNull()) {
+    encoding->set_bitrate_priority(stringToBitratePriority(GetValue<std::string>(*value)));
   }
 
-  value = findEncodableValue(params, "networkPriority");
-  if (!value.IsNull()) {
-    encoding->set_network_priority(stringToRTCPriority(GetValue<std::string>(value)));
+  value = &findEncodableValue(params, keys::kNetworkPriority);
+  if (!value->IsNull()) {
+    encoding->set_network_priority(stringToRTCPriority(GetValue<std::string>(*value)));
   }
 
   return encoding;
@@ -771,59 +773,59 @@ void FlutterPeerConnection::RtpSenderReplaceTrack(
 }
 
 scoped_refptr<RTCRtpParameters> FlutterPeerConnection::updateRtpParameters(
-    EncodableMap newParameters,
+    const EncodableMap& newParameters,
     scoped_refptr<RTCRtpParameters> parameters) {
-  EncodableList encodings = findList(newParameters, "encodings");
+  const EncodableList& encodings = findList(newParameters, keys::kEncodings);
   auto encoding = encodings.begin();
   auto params = parameters->encodings();
   for (auto param : params.std_vector()) {
     if (encoding != encodings.end()) {
-      EncodableMap map = GetValue<EncodableMap>(*encoding);
-      EncodableValue value = findEncodableValue(map, "active");
-      if (!value.IsNull()) {
-        param->set_active(GetValue<bool>(value));
+      const EncodableMap& map = GetValue<EncodableMap>(*encoding);
+      const EncodableValue* value = &findEncodableValue(map, keys::kActive);
+      if (!value->IsNull()) {
+        param->set_active(GetValue<bool>(*value));
       }
-      value = findEncodableValue(map, "rid");
-      if (!value.IsNull()) {
-        param->set_rid(GetValue<std::string>(value));
+      value = &findEncodableValue(map, keys::kRid);
+      if (!value->IsNull()) {
+        param->set_rid(GetValue<std::string>(*value));
       }
-      value = findEncodableValue(map, "ssrc");
-      if (!value.IsNull()) {
-        param->set_ssrc(GetValue<int>(value));
+      value = &findEncodableValue(map, keys::kSsrc);
+      if (!value->IsNull()) {
+        param->set_ssrc(GetValue<int>(*value));
       }
-      value = findEncodableValue(map, "maxBitrate");
-      if (!value.IsNull()) {
-        param->set_max_bitrate_bps(GetValue<int>(value));
+      value = &findEncodableValue(map, keys::kMaxBitrate);
+      if (!value->IsNull()) {
+        param->set_max_bitrate_bps(GetValue<int>(*value));
       }
 
-      value = findEncodableValue(map, "minBitrate");
-      if (!value.IsNull()) {
-        param->set_min_bitrate_bps(GetValue<int>(value));
+      value = &findEncodableValue(map, keys::kMinBitrate);
+      if (!value->IsNull()) {
+        param->set_min_bitrate_bps(GetValue<int>(*value));
       }
 
-      value = findEncodableValue(map, "maxFramerate");
-      if (!value.IsNull()) {
-        param->set_max_framerate(GetValue<int>(value));
+      value = &findEncodableValue(map, keys::kMaxFramerate);
+      if (!value->IsNull()) {
+        param->set_max_framerate(GetValue<int>(*value));
       }
-      value = findEncodableValue(map, "numTemporalLayers");
-      if (!value.IsNull()) {
-        param->set_num_temporal_layers(GetValue<int>(value));
+      value = &findEncodableValue(map, keys::kNumTemporalLayers);
+      if (!value->IsNull()) {
+        param->set_num_temporal_layers(GetValue<int>(*value));
       }
-      value = findEncodableValue(map, "scaleResolutionDownBy");
-      if (!value.IsNull()) {
-        param->set_scale_resolution_down_by(GetValue<double>(value));
+      value = &findEncodableValue(map, keys::kScaleResolutionDownBy);
+      if (!value->IsNull()) {
+        param->set_scale_resolution_down_by(GetValue<double>(*value));
       }
-      value = findEncodableValue(map, "scalabilityMode");
-      if (!value.IsNull()) {
-        param->set_scalability_mode(GetValue<std::string>(value));
+      value = &findEncodableValue(map, keys::kScalabilityMode);
+      if (!value->IsNull()) {
+        param->set_scalability_mode(GetValue<std::string>(*value));
       }
-      value = findEncodableValue(map, "priority");
-      if (!value.IsNull()) {
-        param->set_bitrate_priority(stringToBitratePriority(GetValue<std::string>(value)));
+      value = &findEncodableValue(map, keys::kPriority);
+      if (!value->IsNull()) {
+        param->set_bitrate_priority(stringToBitratePriority(GetValue<std::string>(*value)));
       }
-      value = findEncodableValue(map, "networkPriority");
-      if (!value.IsNull()) {
-        param->set_network_priority(stringToRTCPriority(GetValue<std::string>(value)));
+      value = &findEncodableValue(map, keys::kNetworkPriority);
+      if (!value->IsNull()) {
+        param->set_network_priority(stringToRTCPriority(GetValue<std::string>(*value)));
       }
       encoding++;
     }
@@ -920,9 +922,16 @@ void FlutterPeerConnection::SetConfiguration(
 void FlutterPeerConnection::CaptureFrame(
     RTCVideoTrack* track,
     std::string path,
+    ImageFormat format,
+    int quality,
+    size_t max_width,
+    size_t max_height,
+    std::chrono::milliseconds timeout,
     std::unique_ptr<MethodResultProxy> result) {
-  FlutterFrameCapturer capturer(track, path);
-  capturer.CaptureFrame(std::move(result));
+  auto capturer = std::make_shared<FlutterFrameCapturer>(
+      track, path, format, quality, max_width, max_height,
+      base_->frame_capture_worker());
+  capturer->CaptureFrame(std::move(result), timeout);
 }
 
 scoped_refptr<RTCRtpTransceiver> FlutterPeerConnection::getRtpTransceiverById(
@@ -963,7 +972,7 @@ void FlutterPeerConnection::RtpTransceiverSetDirection(
 void FlutterPeerConnection::RtpTransceiverSetCodecPreferences(
     RTCPeerConnection* pc,
     std::string transceiverId,
-    const EncodableList codecs,
+    const EncodableList& codecs,
     std::unique_ptr<MethodResultProxy> result) {
   std::shared_ptr<MethodResultProxy> result_ptr(result.release());
   auto transceiver = getRtpTransceiverById(pc, transceiverId);
@@ -973,8 +982,8 @@ void FlutterPeerConnection::RtpTransceiverSetCodecPreferences(
     return;
   }
   std::vector<scoped_refptr<RTCRtpCodecCapability>> codecList;
-  for (auto codec : codecs) {
-    auto codecMap = GetValue<EncodableMap>(codec);
+  for (const auto& codec : codecs) {
+    const EncodableMap& codecMap = GetValue<EncodableMap>(codec);
     auto codecMimeType = findString(codecMap, "mimeType");
     auto codecClockRate = findInt(codecMap, "clockRate");
     auto codecNumChannels = findInt(codecMap, "channels");
@@ -1222,6 +1231,17 @@ void FlutterPeerConnection::RemoveTrack(
   result->Success(EncodableValue(map));
 }
 
+namespace {
+
+const EventTemplate kSignalingStateEvent("signalingState");
+const EventTemplate kPeerConnectionStateEvent("peerConnectionState");
+const EventTemplate kIceGatheringStateEvent("iceGatheringState");
+const EventTemplate kIceConnectionStateEvent("iceConnectionState");
+const EventTemplate kCandidateEvent("onCandidate");
+const EventTemplate kRenegotiationNeededEvent("onRenegotiationNeeded");
+
+}  // namespace
+
 FlutterPeerConnectionObserver::FlutterPeerConnectionObserver(
     FlutterWebRTCBase* base,
     scoped_refptr<RTCPeerConnection> peerconnection,
@@ -1229,7 +1249,10 @@ FlutterPeerConnectionObserver::FlutterPeerConnectionObserver(
     TaskRunner* task_runner,
     const std::string& channel_name,
     std::string& peerConnectionId)
-    : event_channel_(EventChannelProxy::Create(messenger, task_runner, channel_name)),
+    : event_channel_(EventChannelProxy::Create(messenger,
+                                               task_runner,
+                                               channel_name,
+                                               TaskPriority::kControl)),
       peerconnection_(peerconnection),
       base_(base),
       id_(peerConnectionId) {
@@ -1238,50 +1261,44 @@ FlutterPeerConnectionObserver::FlutterPeerConnectionObserver(
 
 
 void FlutterPeerConnectionObserver::OnSignalingState(RTCSignalingState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = "signalingState";
-  params[EncodableValue("state")] = signalingStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(kSignalingStateEvent.New()
+                              .Set(keys::kState, signalingStateString(state))
+                              .Build());
 }
 
 void FlutterPeerConnectionObserver::OnPeerConnectionState(
     RTCPeerConnectionState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = "peerConnectionState";
-  params[EncodableValue("state")] = peerConnectionStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(
+      kPeerConnectionStateEvent.New()
+          .Set(keys::kState, peerConnectionStateString(state))
+          .Build());
 }
 
 
 void FlutterPeerConnectionObserver::OnIceGatheringState(
     RTCIceGatheringState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = "iceGatheringState";
-  params[EncodableValue("state")] = iceGatheringStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(
+      kIceGatheringStateEvent.New()
+          .Set(keys::kState, iceGatheringStateString(state))
+          .Build());
 }
 
 void FlutterPeerConnectionObserver::OnIceConnectionState(
     RTCIceConnectionState state) {
-  EncodableMap params;
-  params[EncodableValue("event")] = "iceConnectionState";
-  params[EncodableValue("state")] = iceConnectionStateString(state);
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(
+      kIceConnectionStateEvent.New()
+          .Set(keys::kState, iceConnectionStateString(state))
+          .Build());
 }
 
 void FlutterPeerConnectionObserver::OnIceCandidate(
     scoped_refptr<RTCIceCandidate> candidate) {
-  EncodableMap params;
-  params[EncodableValue("event")] = "onCandidate";
   EncodableMap cand;
-  cand[EncodableValue("candidate")] =
-      EncodableValue(candidate->candidate().std_string());
-  cand[EncodableValue("sdpMLineIndex")] =
-      EncodableValue(candidate->sdp_mline_index());
-  cand[EncodableValue("sdpMid")] =
-      EncodableValue(candidate->sdp_mid().std_string());
-  params[EncodableValue("candidate")] = EncodableValue(cand);
-  event_channel_->Success(EncodableValue(params));
+  cand[keys::kCandidate] = candidate->candidate().std_string();
+  cand[keys::kSdpMLineIndex] = candidate->sdp_mline_index();
+  cand[keys::kSdpMid] = candidate->sdp_mid().std_string();
+  event_channel_->Success(
+      kCandidateEvent.New().Set(keys::kCandidate, std::move(cand)).Build());
 }
 
 void FlutterPeerConnectionObserver::OnAddStream(
@@ -1452,9 +1469,7 @@ void FlutterPeerConnectionObserver::OnDataChannel(
 }
 
 void FlutterPeerConnectionObserver::OnRenegotiationNeeded() {
-  EncodableMap params;
-  params[EncodableValue("event")] = "onRenegotiationNeeded";
-  event_channel_->Success(EncodableValue(params));
+  event_channel_->Success(kRenegotiationNeededEvent.New().Build());
 }
 
 scoped_refptr<RTCMediaStream> FlutterPeerConnectionObserver::MediaStreamForId(
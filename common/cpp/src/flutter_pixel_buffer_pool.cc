@@ -0,0 +1,89 @@
+#include "flutter_pixel_buffer_pool.h"
+
+namespace flutter_webrtc_plugin {
+
+constexpr size_t PixelBufferPool::kMaxPooledBytes;
+constexpr std::chrono::seconds PixelBufferPool::kIdleTimeout;
+
+PixelBufferPool::~PixelBufferPool() {
+  for (auto& buffer : free_) {
+    delete[] buffer.second.data;
+  }
+}
+
+size_t PixelBufferPool::BucketSize(size_t size) {
+  // Four buckets per power of two.
+  size_t power = 1;
+  while (power * 2 <= size) {
+    power *= 2;
+  }
+  size_t step = power >= 4 ? power / 4 : 1;
+  return (size + step - 1) / step * step;
+}
+
+std::shared_ptr<uint8_t> PixelBufferPool::Acquire(size_t size) {
+  size_t bucket = BucketSize(size);
+  uint8_t* data = nullptr;
+  size_t capacity = bucket;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked(std::chrono::steady_clock::now());
+    auto it = free_.lower_bound(bucket);
+    if (it != free_.end() && it->first <= bucket * 2) {
+      data = it->second.data;
+      capacity = it->first;
+      stats_.bytes_pooled -= capacity;
+      stats_.reuses++;
+      free_.erase(it);
+    } else {
+      stats_.allocations++;
+    }
+    stats_.bytes_in_use += capacity;
+  }
+  if (!data) {
+    data = new uint8_t[capacity];
+  }
+
+  std::shared_ptr<PixelBufferPool> pool = shared_from_this();
+  return std::shared_ptr<uint8_t>(
+      data, [pool, capacity](uint8_t* data) { pool->Release(data, capacity); });
+}
+
+PixelBufferPool::Stats PixelBufferPool::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void PixelBufferPool::Release(uint8_t* data, size_t capacity) {
+  auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.bytes_in_use -= capacity;
+  stats_.bytes_pooled += capacity;
+  free_.insert({capacity, {data, now}});
+  TrimLocked(now);
+}
+
+void PixelBufferPool::TrimLocked(std::chrono::steady_clock::time_point now) {
+  for (auto it = free_.begin(); it != free_.end();) {
+    if (now - it->second.released > kIdleTimeout) {
+      stats_.bytes_pooled -= it->first;
+      delete[] it->second.data;
+      it = free_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  while (stats_.bytes_pooled > kMaxPooledBytes) {
+    auto oldest = free_.begin();
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if (it->second.released < oldest->second.released) {
+        oldest = it;
+      }
+    }
+    stats_.bytes_pooled -= oldest->first;
+    delete[] oldest->second.data;
+    free_.erase(oldest);
+  }
+}
+
+}  // namespace flutter_webrtc_plugin
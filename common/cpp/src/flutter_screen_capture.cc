@@ -183,9 +183,9 @@ void FlutterScreenCapture::GetDisplayMedia(
   // unchanged when the constraint is absent — that is libwebrtc's own default.
   bool show_cursor = true;
 
-  const EncodableMap video = findMap(constraints, "video");
+  const EncodableMap& video = findMap(constraints, "video");
   if (video != EncodableMap()) {
-    const EncodableMap deviceId = findMap(video, "deviceId");
+    const EncodableMap& deviceId = findMap(video, "deviceId");
     if (deviceId != EncodableMap()) {
       source_id = findString(deviceId, "exact");
       if (source_id.empty()) {
@@ -196,7 +196,7 @@ void FlutterScreenCapture::GetDisplayMedia(
         // source_type = DesktopType::kWindow;
       }
     }
-    const EncodableMap mandatory = findMap(video, "mandatory");
+    const EncodableMap& mandatory = findMap(video, "mandatory");
     if (mandatory != EncodableMap()) {
       double frameRate = findDouble(mandatory, "frameRate");
       if (frameRate != 0.0) {
@@ -206,7 +206,7 @@ void FlutterScreenCapture::GetDisplayMedia(
     // Accept both the spec's string form ("always"/"never") and a plain bool.
     // Only an explicitly supplied constraint moves off the default, so callers
     // that pass no "cursor" key keep exactly the behaviour they have today.
-    const std::string cursor = findString(video, "cursor");
+    const std::string& cursor = findString(video, "cursor");
     if (!cursor.empty()) {
       show_cursor = (cursor == "always");
     } else if (video.find(EncodableValue("cursor")) != video.end()) {
@@ -0,0 +1,73 @@
+#include "flutter_video_conversion_pool.h"
+
+#include "flutter_video_renderer.h"
+
+namespace flutter_webrtc_plugin {
+
+VideoConversionPool::VideoConversionPool(size_t worker_count) {
+  if (worker_count == 0) {
+    worker_count = 1;
+  }
+  workers_.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&VideoConversionPool::WorkerLoop, this);
+  }
+}
+
+VideoConversionPool::~VideoConversionPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  queue_.clear();
+}
+
+void VideoConversionPool::Schedule(
+    scoped_refptr<FlutterVideoRenderer> renderer) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    queue_.push_back(renderer);
+    if (queue_.size() > peak_queue_depth_) {
+      peak_queue_depth_ = queue_.size();
+    }
+  }
+  cv_.notify_one();
+}
+
+size_t VideoConversionPool::queue_depth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+size_t VideoConversionPool::peak_queue_depth() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peak_queue_depth_;
+}
+
+void VideoConversionPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    if (stopping_) {
+      return;
+    }
+    scoped_refptr<FlutterVideoRenderer> renderer = queue_.front();
+    queue_.pop_front();
+    lock.unlock();
+
+    renderer->ConvertPendingFrame();
+    // Drop the reference outside the lock in case it is the last one.
+    renderer = nullptr;
+
+    lock.lock();
+  }
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -0,0 +1,75 @@
+#include "flutter_video_frame_cache.h"
+
+#include "flutter_video_frame_converter.h"
+
+namespace flutter_webrtc_plugin {
+
+std::shared_ptr<const ConvertedFrame> ConvertVideoFrame(RTCVideoFrame* frame,
+                                                        size_t width,
+                                                        size_t height,
+                                                        PixelBufferPool* pool) {
+  auto converted = std::make_shared<ConvertedFrame>();
+  converted->data = pool->Acquire(width * height * (32 >> 3));
+  converted->width = width;
+  converted->height = height;
+  ConvertYuvToRgb(YuvPlanesFromFrame(frame), RgbFormat::kRGBA, 0,
+                  converted->data.get(), static_cast<int>(width * (32 >> 3)),
+                  static_cast<int>(width), static_cast<int>(height));
+  return converted;
+}
+
+std::shared_ptr<const ConvertedFrame> VideoConversionCache::GetOrConvert(
+    scoped_refptr<RTCVideoFrame> frame,
+    size_t width,
+    size_t height,
+    PixelBufferPool* pool) {
+  std::promise<std::shared_ptr<const ConvertedFrame>> promise;
+  std::shared_future<std::shared_ptr<const ConvertedFrame>> cached;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Entry& entry : entries_) {
+      if (entry.frame->DataY() == frame->DataY() && entry.width == width &&
+          entry.height == height) {
+        cached = entry.result;
+        break;
+      }
+    }
+    if (!cached.valid()) {
+      if (entries_.size() == kMaxEntries) {
+        entries_.pop_front();
+      }
+      entries_.push_back({frame, width, height, promise.get_future().share()});
+    }
+  }
+  if (cached.valid()) {
+    return cached.get();
+  }
+
+  std::shared_ptr<const ConvertedFrame> converted =
+      ConvertVideoFrame(frame.get(), width, height, pool);
+  promise.set_value(converted);
+  return converted;
+}
+
+std::shared_ptr<VideoConversionCache>
+VideoConversionCacheRegistry::CacheForTrack(RTCVideoTrack* track) {
+  if (!track) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = caches_.begin(); it != caches_.end();) {
+    if (it->second.expired()) {
+      it = caches_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  std::shared_ptr<VideoConversionCache> cache = caches_[track].lock();
+  if (!cache) {
+    cache = std::make_shared<VideoConversionCache>();
+    caches_[track] = cache;
+  }
+  return cache;
+}
+
+}  // namespace flutter_webrtc_plugin
@@ -0,0 +1,562 @@
+#include "flutter_video_frame_converter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define FLUTTER_WEBRTC_YUV_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define FLUTTER_WEBRTC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FLUTTER_WEBRTC_TARGET(isa)
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FLUTTER_WEBRTC_YUV_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace flutter_webrtc_plugin {
+
+namespace {
+
+// Converts |width| co-sited Y/U/V samples to 32-bit pixels.
+using YuvToRgbRowFunction = void (*)(const uint8_t* y,
+                                     const uint8_t* u,
+                                     const uint8_t* v,
+                                     uint8_t* dst,
+                                     int width,
+                                     bool bgra);
+
+inline uint8_t Clamp255(int value) {
+  return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// BT.601 limited range with 6-bit fixed point coefficients, the same
+// precision libyuv's portable row functions use. The SIMD kernels below
+// produce identical output.
+void YuvToRgbRowC(const uint8_t* y,
+                  const uint8_t* u,
+                  const uint8_t* v,
+                  uint8_t* dst,
+                  int width,
+                  bool bgra) {
+  const int r_offset = bgra ? 2 : 0;
+  const int b_offset = bgra ? 0 : 2;
+  for (int i = 0; i < width; ++i, dst += 4) {
+    int luma = (y[i] - 16) * 74 + 32;
+    int cb = u[i] - 128;
+    int cr = v[i] - 128;
+    dst[r_offset] = Clamp255((luma + 102 * cr) >> 6);
+    dst[1] = Clamp255((luma - 25 * cb - 52 * cr) >> 6);
+    dst[b_offset] = Clamp255((luma + 129 * cb) >> 6);
+    dst[3] = 255;
+  }
+}
+
+#if defined(FLUTTER_WEBRTC_YUV_X86)
+
+// Intermediate sums stay within int16 except for values that clamp to 255
+// anyway, so saturating adds keep the results exact.
+FLUTTER_WEBRTC_TARGET("sse4.1")
+inline void YuvToRgb8SSE41(const uint8_t* y,
+                           const uint8_t* u,
+                           const uint8_t* v,
+                           __m128i* r,
+                           __m128i* g,
+                           __m128i* b) {
+  __m128i y16 =
+      _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y)));
+  __m128i u16 =
+      _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u)));
+  __m128i v16 =
+      _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v)));
+  __m128i luma = _mm_add_epi16(
+      _mm_mullo_epi16(_mm_sub_epi16(y16, _mm_set1_epi16(16)),
+                      _mm_set1_epi16(74)),
+      _mm_set1_epi16(32));
+  __m128i cb = _mm_sub_epi16(u16, _mm_set1_epi16(128));
+  __m128i cr = _mm_sub_epi16(v16, _mm_set1_epi16(128));
+  *r = _mm_srai_epi16(
+      _mm_adds_epi16(luma, _mm_mullo_epi16(cr, _mm_set1_epi16(102))), 6);
+  *g = _mm_srai_epi16(
+      _mm_subs_epi16(
+          _mm_subs_epi16(luma, _mm_mullo_epi16(cb, _mm_set1_epi16(25))),
+          _mm_mullo_epi16(cr, _mm_set1_epi16(52))),
+      6);
+  *b = _mm_srai_epi16(
+      _mm_adds_epi16(luma, _mm_mullo_epi16(cb, _mm_set1_epi16(129))), 6);
+}
+
+FLUTTER_WEBRTC_TARGET("sse4.1")
+void YuvToRgbRowSSE41(const uint8_t* y,
+                      const uint8_t* u,
+                      const uint8_t* v,
+                      uint8_t* dst,
+                      int width,
+                      bool bgra) {
+  const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xff));
+  int i = 0;
+  for (; i + 16 <= width; i += 16) {
+    __m128i r0, g0, b0, r1, g1, b1;
+    YuvToRgb8SSE41(y + i, u + i, v + i, &r0, &g0, &b0);
+    YuvToRgb8SSE41(y + i + 8, u + i + 8, v + i + 8, &r1, &g1, &b1);
+    __m128i r = _mm_packus_epi16(r0, r1);
+    __m128i g = _mm_packus_epi16(g0, g1);
+    __m128i b = _mm_packus_epi16(b0, b1);
+    if (bgra) {
+      std::swap(r, b);
+    }
+    __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+    __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+    __m128i ba_lo = _mm_unpacklo_epi8(b, alpha);
+    __m128i ba_hi = _mm_unpackhi_epi8(b, alpha);
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i * 4);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(rg_lo, ba_lo));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+  }
+  YuvToRgbRowC(y + i, u + i, v + i, dst + i * 4, width - i, bgra);
+}
+
+FLUTTER_WEBRTC_TARGET("avx2")
+inline void YuvToRgb16AVX2(const uint8_t* y,
+                           const uint8_t* u,
+                           const uint8_t* v,
+                           __m256i* r,
+                           __m256i* g,
+                           __m256i* b) {
+  __m256i y16 = _mm256_cvtepu8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(y)));
+  __m256i u16 = _mm256_cvtepu8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(u)));
+  __m256i v16 = _mm256_cvtepu8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(v)));
+  __m256i luma = _mm256_add_epi16(
+      _mm256_mullo_epi16(_mm256_sub_epi16(y16, _mm256_set1_epi16(16)),
+                         _mm256_set1_epi16(74)),
+      _mm256_set1_epi16(32));
+  __m256i cb = _mm256_sub_epi16(u16, _mm256_set1_epi16(128));
+  __m256i cr = _mm256_sub_epi16(v16, _mm256_set1_epi16(128));
+  *r = _mm256_srai_epi16(
+      _mm256_adds_epi16(luma, _mm256_mullo_epi16(cr, _mm256_set1_epi16(102))),
+      6);
+  *g = _mm256_srai_epi16(
+      _mm256_subs_epi16(
+          _mm256_subs_epi16(luma,
+                            _mm256_mullo_epi16(cb, _mm256_set1_epi16(25))),
+          _mm256_mullo_epi16(cr, _mm256_set1_epi16(52))),
+      6);
+  *b = _mm256_srai_epi16(
+      _mm256_adds_epi16(luma, _mm256_mullo_epi16(cb, _mm256_set1_epi16(129))),
+      6);
+}
+
+FLUTTER_WEBRTC_TARGET("avx2")
+void YuvToRgbRowAVX2(const uint8_t* y,
+                     const uint8_t* u,
+                     const uint8_t* v,
+                     uint8_t* dst,
+                     int width,
+                     bool bgra) {
+  const __m256i alpha = _mm256_set1_epi8(static_cast<char>(0xff));
+  int i = 0;
+  for (; i + 32 <= width; i += 32) {
+    __m256i r0, g0, b0, r1, g1, b1;
+    YuvToRgb16AVX2(y + i, u + i, v + i, &r0, &g0, &b0);
+    YuvToRgb16AVX2(y + i + 16, u + i + 16, v + i + 16, &r1, &g1, &b1);
+    // Packing works per 128-bit lane, so each channel holds pixels
+    // [0-7, 16-23 | 8-15, 24-31]. The unpacks below keep that lane split and
+    // the final permutes restore pixel order.
+    __m256i r = _mm256_packus_epi16(r0, r1);
+    __m256i g = _mm256_packus_epi16(g0, g1);
+    __m256i b = _mm256_packus_epi16(b0, b1);
+    if (bgra) {
+      std::swap(r, b);
+    }
+    __m256i rg_lo = _mm256_unpacklo_epi8(r, g);
+    __m256i rg_hi = _mm256_unpackhi_epi8(r, g);
+    __m256i ba_lo = _mm256_unpacklo_epi8(b, alpha);
+    __m256i ba_hi = _mm256_unpackhi_epi8(b, alpha);
+    __m256i p0 = _mm256_unpacklo_epi16(rg_lo, ba_lo);
+    __m256i p1 = _mm256_unpackhi_epi16(rg_lo, ba_lo);
+    __m256i p2 = _mm256_unpacklo_epi16(rg_hi, ba_hi);
+    __m256i p3 = _mm256_unpackhi_epi16(rg_hi, ba_hi);
+    __m256i* out = reinterpret_cast<__m256i*>(dst + i * 4);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(p0, p1, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(p0, p1, 0x31));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(p2, p3, 0x20));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+  }
+  YuvToRgbRowC(y + i, u + i, v + i, dst + i * 4, width - i, bgra);
+}
+
+struct X86Features {
+  bool sse41 = false;
+  bool avx2 = false;
+};
+
+X86Features DetectX86Features() {
+  X86Features features;
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  int max_leaf = info[0];
+  __cpuid(info, 1);
+  features.sse41 = (info[2] & (1 << 19)) != 0;
+  bool os_saves_avx = (info[2] & (1 << 27)) != 0 &&
+                      (info[2] & (1 << 28)) != 0 &&
+                      (_xgetbv(0) & 0x6) == 0x6;
+  if (max_leaf >= 7 && os_saves_avx) {
+    __cpuidex(info, 7, 0);
+    features.avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  features.sse41 = __builtin_cpu_supports("sse4.1");
+  features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+  return features;
+}
+
+#endif  // FLUTTER_WEBRTC_YUV_X86
+
+#if defined(FLUTTER_WEBRTC_YUV_NEON)
+
+void YuvToRgbRowNEON(const uint8_t* y,
+                     const uint8_t* u,
+                     const uint8_t* v,
+                     uint8_t* dst,
+                     int width,
+                     bool bgra) {
+  const int16x8_t y_offset = vdupq_n_s16(16);
+  const int16x8_t uv_offset = vdupq_n_s16(128);
+  const int16x8_t rounding = vdupq_n_s16(32);
+  int i = 0;
+  for (; i + 8 <= width; i += 8) {
+    int16x8_t y16 = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + i)));
+    int16x8_t cb =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + i))), uv_offset);
+    int16x8_t cr =
+        vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + i))), uv_offset);
+    int16x8_t luma =
+        vaddq_s16(vmulq_n_s16(vsubq_s16(y16, y_offset), 74), rounding);
+    uint8x8_t r =
+        vqmovun_s16(vshrq_n_s16(vqaddq_s16(luma, vmulq_n_s16(cr, 102)), 6));
+    uint8x8_t g = vqmovun_s16(vshrq_n_s16(
+        vqsubq_s16(vqsubq_s16(luma, vmulq_n_s16(cb, 25)), vmulq_n_s16(cr, 52)),
+        6));
+    uint8x8_t b =
+        vqmovun_s16(vshrq_n_s16(vqaddq_s16(luma, vmulq_n_s16(cb, 129)), 6));
+    uint8x8x4_t pixels;
+    pixels.val[0] = bgra ? b : r;
+    pixels.val[1] = g;
+    pixels.val[2] = bgra ? r : b;
+    pixels.val[3] = vdup_n_u8(255);
+    vst4_u8(dst + i * 4, pixels);
+  }
+  YuvToRgbRowC(y + i, u + i, v + i, dst + i * 4, width - i, bgra);
+}
+
+#endif  // FLUTTER_WEBRTC_YUV_NEON
+
+struct RowKernel {
+  YuvToRgbRowFunction function;
+  const char* name;
+};
+
+RowKernel SelectRowKernel() {
+#if defined(FLUTTER_WEBRTC_YUV_X86)
+  X86Features features = DetectX86Features();
+  if (features.avx2) {
+    return {YuvToRgbRowAVX2, "avx2"};
+  }
+  if (features.sse41) {
+    return {YuvToRgbRowSSE41, "sse4.1"};
+  }
+#elif defined(FLUTTER_WEBRTC_YUV_NEON)
+  return {YuvToRgbRowNEON, "neon"};
+#endif
+  return {YuvToRgbRowC, "c"};
+}
+
+// Starts out as the kernel picked for this CPU; SetYuvToRgbKernel() may swap
+// it for another one.
+std::atomic<const RowKernel*>& CurrentRowKernel() {
+  static const RowKernel selected = SelectRowKernel();
+  static std::atomic<const RowKernel*> current(&selected);
+  return current;
+}
+
+const RowKernel& GetRowKernel() {
+  return *CurrentRowKernel().load(std::memory_order_acquire);
+}
+
+bool IsRowKernelSupported(const RowKernel& kernel) {
+#if defined(FLUTTER_WEBRTC_YUV_X86)
+  X86Features features = DetectX86Features();
+  if (kernel.function == YuvToRgbRowAVX2) {
+    return features.avx2;
+  }
+  if (kernel.function == YuvToRgbRowSSE41) {
+    return features.sse41;
+  }
+#endif
+  return true;
+}
+
+// Sampling position of the first output pixel and the per-pixel step, both in
+// 16.16 fixed point, so that output pixel centers map onto source pixel
+// centers.
+struct SampleStep {
+  int64_t start;
+  int64_t step;
+};
+
+SampleStep ComputeSampleStep(int src_size, int dst_size) {
+  int64_t step = (static_cast<int64_t>(src_size) << 16) / dst_size;
+  return {step / 2 - (1 << 15), step};
+}
+
+// Splits a 16.16 position into the index of the left/top source sample and an
+// 8-bit weight for the sample after it.
+inline void SplitPosition(int64_t position, int* index, int* fraction) {
+  if (position < 0) {
+    position = 0;
+  }
+  *index = static_cast<int>(position >> 16);
+  *fraction = static_cast<int>((position >> 8) & 0xff);
+}
+
+// Produces one output row by blending |row0| and |row1| with |y_fraction| and
+// filtering horizontally from |src_width| to |dst_width| samples that are
+// |pixel_step| bytes apart in the source.
+void ScaleRowBilinear(const uint8_t* row0,
+                      const uint8_t* row1,
+                      int y_fraction,
+                      int src_width,
+                      int pixel_step,
+                      uint8_t* dst,
+                      int dst_width) {
+  SampleStep x_step = ComputeSampleStep(src_width, dst_width);
+  int64_t position = x_step.start;
+  const int last = src_width - 1;
+  for (int i = 0; i < dst_width; ++i, position += x_step.step) {
+    int x0, x_fraction;
+    SplitPosition(position, &x0, &x_fraction);
+    int x1 = x0 < last ? x0 + 1 : last;
+    x0 *= pixel_step;
+    x1 *= pixel_step;
+    int top = row0[x0] * (256 - x_fraction) + row0[x1] * x_fraction;
+    int bottom = row1[x0] * (256 - x_fraction) + row1[x1] * x_fraction;
+    dst[i] = static_cast<uint8_t>(
+        (top * (256 - y_fraction) + bottom * y_fraction + (1 << 15)) >> 16);
+  }
+}
+
+// Scales output row |dst_y| of a plane.
+void ScalePlaneRow(const uint8_t* plane,
+                   int stride,
+                   int src_width,
+                   int src_height,
+                   int pixel_step,
+                   const SampleStep& y_step,
+                   int dst_y,
+                   uint8_t* dst,
+                   int dst_width) {
+  int y0, y_fraction;
+  SplitPosition(y_step.start + y_step.step * dst_y, &y0, &y_fraction);
+  int y1 = std::min(y0 + 1, src_height - 1);
+  ScaleRowBilinear(plane + static_cast<ptrdiff_t>(y0) * stride,
+                   plane + static_cast<ptrdiff_t>(y1) * stride, y_fraction,
+                   src_width, pixel_step, dst, dst_width);
+}
+
+// Repeats each chroma sample of source row |src_y| for the two luma samples
+// it covers.
+void UpsampleChromaRow(const YuvPlanes& src,
+                       int src_y,
+                       uint8_t* u_row,
+                       uint8_t* v_row) {
+  int chroma_y = src_y / 2;
+  if (src.layout == YuvLayout::kNV12) {
+    const uint8_t* uv = src.u + static_cast<ptrdiff_t>(chroma_y) * src.stride_u;
+    for (int i = 0; i < src.width; ++i) {
+      u_row[i] = uv[(i / 2) * 2];
+      v_row[i] = uv[(i / 2) * 2 + 1];
+    }
+    return;
+  }
+  const uint8_t* u = src.u + static_cast<ptrdiff_t>(chroma_y) * src.stride_u;
+  const uint8_t* v = src.v + static_cast<ptrdiff_t>(chroma_y) * src.stride_v;
+  for (int i = 0; i < src.width; ++i) {
+    u_row[i] = u[i / 2];
+    v_row[i] = v[i / 2];
+  }
+}
+
+// Writes |row|, row |y| of the unrotated |width| x |height| image, to its
+// place in |dst| after rotating the image clockwise by |rotation| degrees.
+void StoreRotatedRow(const uint8_t* row,
+                     int width,
+                     int height,
+                     int y,
+                     int rotation,
+                     uint8_t* dst,
+                     int dst_stride) {
+  for (int x = 0; x < width; ++x) {
+    int dst_x, dst_y;
+    switch (rotation) {
+      case 90:
+        dst_x = height - 1 - y;
+        dst_y = x;
+        break;
+      case 180:
+        dst_x = width - 1 - x;
+        dst_y = height - 1 - y;
+        break;
+      default:  // 270
+        dst_x = y;
+        dst_y = width - 1 - x;
+        break;
+    }
+    memcpy(dst + static_cast<ptrdiff_t>(dst_y) * dst_stride + dst_x * 4,
+           row + x * 4, 4);
+  }
+}
+
+}  // namespace
+
+YuvPlanes YuvPlanesFromFrame(RTCVideoFrame* frame) {
+  YuvPlanes planes;
+  planes.layout = YuvLayout::kI420;
+  planes.y = frame->DataY();
+  planes.u = frame->DataU();
+  planes.v = frame->DataV();
+  planes.stride_y = frame->StrideY();
+  planes.stride_u = frame->StrideU();
+  planes.stride_v = frame->StrideV();
+  planes.width = frame->width();
+  planes.height = frame->height();
+  return planes;
+}
+
+void FitFrameSize(size_t src_width,
+                  size_t src_height,
+                  size_t box_width,
+                  size_t box_height,
+                  size_t* out_width,
+                  size_t* out_height) {
+  *out_width = src_width;
+  *out_height = src_height;
+  if (src_width == 0 || src_height == 0 || box_width == 0 ||
+      box_height == 0) {
+    return;
+  }
+  if (box_width >= src_width && box_height >= src_height) {
+    return;
+  }
+  if (box_width * src_height <= box_height * src_width) {
+    *out_width = box_width;
+    *out_height = std::max<size_t>(1, src_height * box_width / src_width);
+  } else {
+    *out_height = box_height;
+    *out_width = std::max<size_t>(1, src_width * box_height / src_height);
+  }
+}
+
+void ConvertYuvToRgb(const YuvPlanes& src,
+                     RgbFormat format,
+                     int rotation,
+                     uint8_t* dst,
+                     int dst_stride,
+                     int dst_width,
+                     int dst_height) {
+  if (src.width <= 0 || src.height <= 0 || dst_width <= 0 || dst_height <= 0) {
+    return;
+  }
+  rotation = ((rotation % 360) + 360) % 360;
+  const bool transpose = rotation == 90 || rotation == 270;
+  // Size of the image before rotation.
+  const int width = transpose ? dst_height : dst_width;
+  const int height = transpose ? dst_width : dst_height;
+  const bool scale = width != src.width || height != src.height;
+  const bool bgra = format == RgbFormat::kBGRA;
+  const YuvToRgbRowFunction convert_row = GetRowKernel().function;
+
+  const int chroma_width = (src.width + 1) / 2;
+  const int chroma_height = (src.height + 1) / 2;
+  const bool nv12 = src.layout == YuvLayout::kNV12;
+  SampleStep luma_step = ComputeSampleStep(src.height, height);
+  SampleStep chroma_step = ComputeSampleStep(chroma_height, height);
+
+  // Chroma is always expanded to one sample per output pixel so the row
+  // kernels only deal with co-sited samples. Rotated rows are converted into
+  // |rgb_row| first and then scattered into place.
+  std::vector<uint8_t> rows(static_cast<size_t>(width) *
+                            (rotation != 0 ? 7 : 3));
+  uint8_t* y_row = rows.data();
+  uint8_t* u_row = y_row + width;
+  uint8_t* v_row = u_row + width;
+  uint8_t* rgb_row = v_row + width;
+
+  for (int y = 0; y < height; ++y) {
+    const uint8_t* luma = y_row;
+    if (scale) {
+      ScalePlaneRow(src.y, src.stride_y, src.width, src.height, 1, luma_step,
+                    y, y_row, width);
+      ScalePlaneRow(src.u, src.stride_u, chroma_width, chroma_height,
+                    nv12 ? 2 : 1, chroma_step, y, u_row, width);
+      ScalePlaneRow(nv12 ? src.u + 1 : src.v,
+                    nv12 ? src.stride_u : src.stride_v, chroma_width,
+                    chroma_height, nv12 ? 2 : 1, chroma_step, y, v_row, width);
+    } else {
+      luma = src.y + static_cast<ptrdiff_t>(y) * src.stride_y;
+      UpsampleChromaRow(src, y, u_row, v_row);
+    }
+
+    if (rotation == 0) {
+      convert_row(luma, u_row, v_row,
+                  dst + static_cast<ptrdiff_t>(y) * dst_stride, width, bgra);
+    } else {
+      convert_row(luma, u_row, v_row, rgb_row, width, bgra);
+      StoreRotatedRow(rgb_row, width, height, y, rotation, dst, dst_stride);
+    }
+  }
+}
+
+const char* YuvToRgbKernelName() {
+  return GetRowKernel().name;
+}
+
+bool SetYuvToRgbKernel(const char* name) {
+  static const RowKernel kKernels[] = {
+#if defined(FLUTTER_WEBRTC_YUV_X86)
+      {YuvToRgbRowAVX2, "avx2"},
+      {YuvToRgbRowSSE41, "sse4.1"},
+#elif defined(FLUTTER_WEBRTC_YUV_NEON)
+      {YuvToRgbRowNEON, "neon"},
+#endif
+      {YuvToRgbRowC, "c"},
+  };
+  for (const RowKernel& kernel : kKernels) {
+    if (strcmp(kernel.name, name) == 0) {
+      if (!IsRowKernelSupported(kernel)) {
+        return false;
+      }
+      CurrentRowKernel().store(&kernel, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace flutter_webrtc_plugin
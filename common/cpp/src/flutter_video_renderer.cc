@@ -1,7 +1,17 @@
 #include "flutter_video_renderer.h"
 
+#include "flutter_event_builder.h"
+
 namespace flutter_webrtc_plugin {
 
+namespace {
+
+const EventTemplate kFirstFrameRenderedEvent("didFirstFrameRendered");
+const EventTemplate kRotationChangedEvent("didTextureChangeRotation");
+const EventTemplate kVideoSizeChangedEvent("didTextureChangeVideoSize");
+
+}  // namespace
+
 FlutterVideoRenderer::~FlutterVideoRenderer() {}
 
 void FlutterVideoRenderer::initialize(
@@ -9,76 +19,198 @@ void FlutterVideoRenderer::initialize(
     BinaryMessenger* messenger,
     TaskRunner* task_runner,
     std::unique_ptr<flutter::TextureVariant> texture,
-    int64_t trxture_id) {
+    int64_t trxture_id,
+    VideoConversionPool* conversion_pool,
+    VideoConversionCacheRegistry* conversion_caches,
+    PixelBufferPool* buffer_pool) {
   registrar_ = registrar;
+  conversion_pool_ = conversion_pool;
+  conversion_caches_ = conversion_caches;
+  buffer_pool_ = buffer_pool;
   texture_ = std::move(texture);
   texture_id_ = trxture_id;
   std::string channel_name =
       "FlutterWebRTC/Texture" + std::to_string(texture_id_);
-  event_channel_ = EventChannelProxy::Create(messenger, task_runner, channel_name);
+  event_channel_ = EventChannelProxy::Create(
+      messenger, task_runner, channel_name, TaskPriority::kMediaEvents,
+      EventDropPolicy::kCoalesce);
 }
 
 const FlutterDesktopPixelBuffer* FlutterVideoRenderer::CopyPixelBuffer(
     size_t width,
-    size_t height) const {
-  mutex_.lock();
-  if (pixel_buffer_.get() && frame_.get()) {
-    if (pixel_buffer_->width != frame_->width() ||
-        pixel_buffer_->height != frame_->height()) {
-      size_t buffer_size =
-          (size_t(frame_->width()) * size_t(frame_->height())) * (32 >> 3);
-      rgb_buffer_.reset(new uint8_t[buffer_size]);
-      pixel_buffer_->width = frame_->width();
-      pixel_buffer_->height = frame_->height();
-    }
+    size_t height) {
+  target_width_.store(width, std::memory_order_relaxed);
+  target_height_.store(height, std::memory_order_relaxed);
 
-    frame_->ConvertToARGB(RTCVideoFrame::Type::kABGR, rgb_buffer_.get(), 0,
-                          static_cast<int>(pixel_buffer_->width),
-                          static_cast<int>(pixel_buffer_->height));
+  // Take the newest completed frame if the producer published one since the
+  // last call, otherwise keep handing back the buffer we already own.
+  if (shared_state_.load(std::memory_order_acquire) & kFreshFrameBit) {
+    uint32_t previous =
+        shared_state_.exchange(read_index_, std::memory_order_acq_rel);
+    read_index_ = previous & kSlotIndexMask;
+    frames_rendered_.fetch_add(1, std::memory_order_relaxed);
+    frame_age_.Record(std::chrono::steady_clock::now() -
+                      buffers_[read_index_].received);
+    OnFrameConsumed();
+  }
 
-    pixel_buffer_->buffer = rgb_buffer_.get();
-    mutex_.unlock();
-    return pixel_buffer_.get();
+  const RenderBuffer& current = buffers_[read_index_];
+  if (current.pixels.buffer == nullptr) {
+    return nullptr;
   }
-  mutex_.unlock();
-  return nullptr;
+  return &current.pixels;
 }
 
 void FlutterVideoRenderer::OnFrame(scoped_refptr<RTCVideoFrame> frame) {
+  auto received = std::chrono::steady_clock::now();
+  frames_received_.fetch_add(1, std::memory_order_relaxed);
   if (!first_frame_rendered) {
-    EncodableMap params;
-    params[EncodableValue("event")] = "didFirstFrameRendered";
-    params[EncodableValue("id")] = EncodableValue(texture_id_);
-    event_channel_->Success(EncodableValue(params));
-    pixel_buffer_.reset(new FlutterDesktopPixelBuffer());
-    pixel_buffer_->width = 0;
-    pixel_buffer_->height = 0;
+    event_channel_->Success(
+        kFirstFrameRenderedEvent.New().Set(keys::kId, texture_id_).Build());
     first_frame_rendered = true;
   }
   if (rotation_ != frame->rotation()) {
-    EncodableMap params;
-    params[EncodableValue("event")] = "didTextureChangeRotation";
-    params[EncodableValue("id")] = EncodableValue(texture_id_);
-    params[EncodableValue("rotation")] =
-        EncodableValue((int32_t)frame->rotation());
-    event_channel_->Success(EncodableValue(params));
+    event_channel_->Success(
+        kRotationChangedEvent.New()
+            .Set(keys::kId, texture_id_)
+            .Set(keys::kRotation, (int32_t)frame->rotation())
+            .Build());
     rotation_ = frame->rotation();
   }
   if (last_frame_size_.width != frame->width() ||
       last_frame_size_.height != frame->height()) {
-    EncodableMap params;
-    params[EncodableValue("event")] = "didTextureChangeVideoSize";
-    params[EncodableValue("id")] = EncodableValue(texture_id_);
-    params[EncodableValue("width")] = EncodableValue((int32_t)frame->width());
-    params[EncodableValue("height")] = EncodableValue((int32_t)frame->height());
-    event_channel_->Success(EncodableValue(params));
+    event_channel_->Success(kVideoSizeChangedEvent.New()
+                                .Set(keys::kId, texture_id_)
+                                .Set(keys::kWidth, (int32_t)frame->width())
+                                .Set(keys::kHeight, (int32_t)frame->height())
+                                .Build());
 
     last_frame_size_ = {(size_t)frame->width(), (size_t)frame->height()};
   }
-  mutex_.lock();
-  frame_ = frame;
-  mutex_.unlock();
-  registrar_->MarkTextureFrameAvailable(texture_id_);
+
+  if (ShouldDropFrame()) {
+    frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (pending_frame_) {
+      frames_skipped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending_frame_ = frame;
+    pending_frame_received_ = received;
+    schedule = !conversion_scheduled_ && !awaiting_consume_;
+    if (schedule) {
+      conversion_scheduled_ = true;
+    }
+  }
+  if (schedule) {
+    conversion_pool_->Schedule(this);
+  }
+}
+
+bool FlutterVideoRenderer::ShouldDropFrame() {
+  double max_frame_rate = max_frame_rate_.load(std::memory_order_relaxed);
+  if (max_frame_rate <= 0) {
+    return false;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (now < next_frame_time_) {
+    return true;
+  }
+  // Advance from the previous slot rather than from |now| so jittery input
+  // still averages out to the cap, but don't bank credit across long gaps.
+  auto interval =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / max_frame_rate));
+  next_frame_time_ += interval;
+  if (next_frame_time_ <= now) {
+    next_frame_time_ = now + interval;
+  }
+  return false;
+}
+
+void FlutterVideoRenderer::ConvertPendingFrame() {
+  scoped_refptr<RTCVideoFrame> frame;
+  std::chrono::steady_clock::time_point received;
+  std::shared_ptr<VideoConversionCache> cache;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    frame = pending_frame_;
+    received = pending_frame_received_;
+    pending_frame_ = nullptr;
+    cache = conversion_cache_;
+  }
+  if (frame) {
+    ConvertFrame(frame, received, cache.get());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    conversion_scheduled_ = false;
+    if (frame) {
+      awaiting_consume_ = true;
+    }
+  }
+  if (frame) {
+    registrar_->MarkTextureFrameAvailable(texture_id_);
+  }
+}
+
+void FlutterVideoRenderer::DropPendingFrame() {
+  std::lock_guard<std::mutex> lock(pending_mutex_);
+  pending_frame_ = nullptr;
+}
+
+void FlutterVideoRenderer::OnFrameConsumed() {
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    awaiting_consume_ = false;
+    schedule = pending_frame_ && !conversion_scheduled_;
+    if (schedule) {
+      conversion_scheduled_ = true;
+    }
+  }
+  if (schedule) {
+    conversion_pool_->Schedule(this);
+  }
+}
+
+void FlutterVideoRenderer::ConvertFrame(
+    scoped_refptr<RTCVideoFrame> frame,
+    std::chrono::steady_clock::time_point received,
+    VideoConversionCache* cache) {
+  auto started = std::chrono::steady_clock::now();
+  size_t source_width = static_cast<size_t>(frame->width());
+  size_t source_height = static_cast<size_t>(frame->height());
+  size_t width = source_width;
+  size_t height = source_height;
+  if (!full_resolution_.load(std::memory_order_relaxed)) {
+    FitFrameSize(source_width, source_height,
+                 target_width_.load(std::memory_order_relaxed),
+                 target_height_.load(std::memory_order_relaxed), &width,
+                 &height);
+  }
+
+  RenderBuffer& target = buffers_[write_index_];
+  target.frame =
+      cache ? cache->GetOrConvert(frame, width, height, buffer_pool_)
+            : ConvertVideoFrame(frame.get(), width, height, buffer_pool_);
+  target.pixels.buffer = target.frame->data.get();
+  target.pixels.width = width;
+  target.pixels.height = height;
+  target.received = received;
+  conversion_time_.Record(std::chrono::steady_clock::now() - started);
+  frames_converted_.fetch_add(1, std::memory_order_relaxed);
+
+  // Publish the converted slot and take back whichever one the consumer is
+  // not holding.
+  uint32_t previous = shared_state_.exchange(write_index_ | kFreshFrameBit,
+                                             std::memory_order_acq_rel);
+  write_index_ = previous & kSlotIndexMask;
 }
 
 void FlutterVideoRenderer::SetVideoTrack(scoped_refptr<RTCVideoTrack> track) {
@@ -86,6 +218,10 @@ void FlutterVideoRenderer::SetVideoTrack(scoped_refptr<RTCVideoTrack> track) {
     if (track_)
       track_->RemoveRenderer(this);
     track_ = track;
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      conversion_cache_ = conversion_caches_->CacheForTrack(track_.get());
+    }
     last_frame_size_ = {0, 0};
     first_frame_rendered = false;
     if (track_)
@@ -93,6 +229,24 @@ void FlutterVideoRenderer::SetVideoTrack(scoped_refptr<RTCVideoTrack> track) {
   }
 }
 
+EncodableMap FlutterVideoRenderer::GetStats() const {
+  EncodableMap stats;
+  stats[EncodableValue("framesReceived")] = EncodableValue(
+      static_cast<int64_t>(frames_received_.load(std::memory_order_relaxed)));
+  stats[EncodableValue("framesConverted")] = EncodableValue(
+      static_cast<int64_t>(frames_converted_.load(std::memory_order_relaxed)));
+  stats[EncodableValue("framesRendered")] = EncodableValue(
+      static_cast<int64_t>(frames_rendered_.load(std::memory_order_relaxed)));
+  stats[EncodableValue("framesDropped")] = EncodableValue(
+      static_cast<int64_t>(frames_dropped_.load(std::memory_order_relaxed)));
+  stats[EncodableValue("framesSkipped")] = EncodableValue(
+      static_cast<int64_t>(frames_skipped_.load(std::memory_order_relaxed)));
+  stats[EncodableValue("conversionTime")] =
+      EncodableValue(conversion_time_.ToMap());
+  stats[EncodableValue("frameAge")] = EncodableValue(frame_age_.ToMap());
+  return stats;
+}
+
 bool FlutterVideoRenderer::CheckMediaStream(std::string mediaId) {
   if (0 == mediaId.size() || 0 == media_stream_id.size()) {
     return false;
@@ -109,7 +263,30 @@ bool FlutterVideoRenderer::CheckVideoTrack(std::string mediaId) {
 
 FlutterVideoRendererManager::FlutterVideoRendererManager(
     FlutterWebRTCBase* base)
-    : base_(base) {}
+    : base_(base),
+      buffer_pool_(std::make_shared<PixelBufferPool>()),
+      conversion_pool_(
+          new VideoConversionPool(std::thread::hardware_concurrency())) {}
+
+FlutterVideoRendererManager::~FlutterVideoRendererManager() {
+  // Stop every source of conversions before the pool goes away: frame
+  // delivery, the frame a late CopyPixelBuffer would schedule, and the
+  // engine's calls into the texture.
+  for (auto& it : renderers_) {
+    it.second->SetVideoTrack(nullptr);
+    it.second->DropPendingFrame();
+#if defined(_WINDOWS)
+    // The engine may call the texture until the unregistration completes.
+    scoped_refptr<FlutterVideoRenderer> renderer = it.second;
+    base_->textures_->UnregisterTexture(it.first, [renderer] {});
+#else
+    base_->textures_->UnregisterTexture(it.first);
+#endif
+  }
+  // Joins the workers; any conversion still queued is discarded.
+  conversion_pool_.reset();
+  renderers_.clear();
+}
 
 void FlutterVideoRendererManager::CreateVideoRendererTexture(
     std::unique_ptr<MethodResultProxy> result) {
@@ -123,7 +300,9 @@ void FlutterVideoRendererManager::CreateVideoRendererTexture(
 
   auto texture_id = base_->textures_->RegisterTexture(textureVariant.get());
   texture->initialize(base_->textures_, base_->messenger_, base_->task_runner_,
-                      std::move(textureVariant), texture_id);
+                      std::move(textureVariant), texture_id,
+                      conversion_pool_.get(), &conversion_caches_,
+                      buffer_pool_.get());
   renderers_[texture_id] = texture;
   EncodableMap params;
   params[EncodableValue("textureId")] = EncodableValue(texture_id);
@@ -162,6 +341,38 @@ void FlutterVideoRendererManager::VideoRendererSetSrcObject(
   }
 }
 
+void FlutterVideoRendererManager::VideoRendererSetOptions(
+    int64_t texture_id,
+    const EncodableMap& options,
+    std::unique_ptr<MethodResultProxy> result) {
+  auto it = renderers_.find(texture_id);
+  if (it == renderers_.end()) {
+    result->Error("VideoRendererSetOptionsFailed",
+                  "VideoRendererSetOptions() texture not found!");
+    return;
+  }
+  auto full_resolution = options.find(EncodableValue("fullResolution"));
+  if (full_resolution != options.end() &&
+      TypeIs<bool>(full_resolution->second)) {
+    it->second->SetFullResolution(GetValue<bool>(full_resolution->second));
+  }
+  auto max_frame_rate = options.find(EncodableValue("maxFrameRate"));
+  if (max_frame_rate != options.end()) {
+    const EncodableValue& value = max_frame_rate->second;
+    if (TypeIs<double>(value)) {
+      it->second->SetMaxFrameRate(GetValue<double>(value));
+    } else if (TypeIs<int32_t>(value)) {
+      it->second->SetMaxFrameRate(GetValue<int32_t>(value));
+    } else if (TypeIs<int64_t>(value)) {
+      it->second->SetMaxFrameRate(
+          static_cast<double>(GetValue<int64_t>(value)));
+    } else if (value.IsNull()) {
+      it->second->SetMaxFrameRate(0);
+    }
+  }
+  result->Success();
+}
+
 void FlutterVideoRendererManager::VideoRendererDispose(
     int64_t texture_id,
     std::unique_ptr<MethodResultProxy> result) {
@@ -182,4 +393,46 @@ void FlutterVideoRendererManager::VideoRendererDispose(
                 "VideoRendererDispose() texture not found!");
 }
 
+void FlutterVideoRendererManager::VideoRendererGetStats(
+    const EncodableMap& options,
+    std::unique_ptr<MethodResultProxy> result) {
+  EncodableMap params;
+  params[EncodableValue("conversionWorkers")] =
+      EncodableValue(static_cast<int64_t>(conversion_pool_->worker_count()));
+  params[EncodableValue("conversionQueueDepth")] =
+      EncodableValue(static_cast<int64_t>(conversion_pool_->queue_depth()));
+  params[EncodableValue("conversionQueuePeak")] = EncodableValue(
+      static_cast<int64_t>(conversion_pool_->peak_queue_depth()));
+  params[EncodableValue("conversionKernel")] =
+      EncodableValue(std::string(YuvToRgbKernelName()));
+  PixelBufferPool::Stats buffers = buffer_pool_->stats();
+  params[EncodableValue("pixelBufferAllocations")] =
+      EncodableValue(static_cast<int64_t>(buffers.allocations));
+  params[EncodableValue("pixelBufferReuses")] =
+      EncodableValue(static_cast<int64_t>(buffers.reuses));
+  params[EncodableValue("pixelBufferBytesInUse")] =
+      EncodableValue(static_cast<int64_t>(buffers.bytes_in_use));
+  params[EncodableValue("pixelBufferBytesPooled")] =
+      EncodableValue(static_cast<int64_t>(buffers.bytes_pooled));
+
+  int64_t texture_id = findLongInt(options, "textureId");
+  if (texture_id != -1) {
+    auto it = renderers_.find(texture_id);
+    if (it == renderers_.end()) {
+      result->Error("VideoRendererGetStatsFailed",
+                    "VideoRendererGetStats() texture not found!");
+      return;
+    }
+    params[EncodableValue("texture")] = EncodableValue(it->second->GetStats());
+  } else {
+    EncodableMap textures;
+    for (auto& renderer : renderers_) {
+      textures[EncodableValue(renderer.first)] =
+          EncodableValue(renderer.second->GetStats());
+    }
+    params[EncodableValue("textures")] = EncodableValue(textures);
+  }
+  result->Success(EncodableValue(params));
+}
+
 }  // namespace flutter_webrtc_plugin
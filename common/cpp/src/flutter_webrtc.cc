@@ -17,97 +17,104 @@ FlutterWebRTC::FlutterWebRTC(FlutterWebRTCPlugin* plugin)
       FlutterScreenCapture::FlutterScreenCapture(this),
       FlutterDataChannel::FlutterDataChannel(this),
       FlutterFrameCryptor::FlutterFrameCryptor(this),
-      FlutterDataPacketCryptor::FlutterDataPacketCryptor(this) {}
+      FlutterDataPacketCryptor::FlutterDataPacketCryptor(this),
+      FlutterFrameTapManager::FlutterFrameTapManager(this),
+      FlutterMediaRecorderManager::FlutterMediaRecorderManager(this),
+      FlutterFrameDumpManager::FlutterFrameDumpManager(this) {
+  RegisterMethods();
+}
 
 FlutterWebRTC::~FlutterWebRTC() {}
 
 void FlutterWebRTC::HandleMethodCall(
     const MethodCallProxy& method_call,
     std::unique_ptr<MethodResultProxy> result) {
-  if (method_call.method_name().compare("initialize") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap options = findMap(params, "options");
+  Dispatch(method_call, std::move(result));
+}
+
+void FlutterWebRTC::RegisterMethods() {
+  Register("initialize", [this](auto& call, auto result) {
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const EncodableMap& options = findMap(params, "options");
     std::string severityStr = findString(options, "logSeverity");
     if (severityStr.empty() == false) {
       RTCLoggingSeverity severity = str2LogSeverity(severityStr);
       initLoggerCallback(severity);
     }
     result->Success();
-  } else if (method_call.method_name().compare("createPeerConnection") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("createPeerConnection", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap configuration = findMap(params, "configuration");
-    const EncodableMap constraints = findMap(params, "constraints");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const EncodableMap& configuration = findMap(params, "configuration");
+    const EncodableMap& constraints = findMap(params, "constraints");
     CreateRTCPeerConnection(configuration, constraints, std::move(result));
-  } else if (method_call.method_name().compare("getUserMedia") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getUserMedia", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const EncodableMap& constraints = findMap(params, "constraints");
     GetUserMedia(constraints, std::move(result));
-  } else if (method_call.method_name().compare("getDisplayMedia") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getDisplayMedia", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const EncodableMap constraints = findMap(params, "constraints");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const EncodableMap& constraints = findMap(params, "constraints");
 
     GetDisplayMedia(constraints, std::move(result));
-  } else if (method_call.method_name().compare("getDesktopSources") == 0) {
+  });
+  Register("getDesktopSources", [this](auto& call, auto result) {
     // types: ["screen", "window"]
-    if (!method_call.arguments()) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Bad arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const EncodableList types = findList(params, "types");
+    const EncodableList& types = findList(params, "types");
     if (types.empty()) {
       result->Error("Bad Arguments", "Types is required");
       return;
     }
     GetDesktopSources(types, std::move(result));
-  } else if (method_call.method_name().compare("updateDesktopSources") == 0) {
+  });
+  Register("updateDesktopSources", [this](auto& call, auto result) {
     // types: ["screen", "window"]
-    if (!method_call.arguments()) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Bad arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const EncodableList types = findList(params, "types");
+    const EncodableList& types = findList(params, "types");
     if (types.empty()) {
       result->Error("Bad Arguments", "Types is required");
       return;
     }
     UpdateDesktopSources(types, std::move(result));
-  } else if (method_call.method_name().compare("getDesktopSourceThumbnail") ==
-             0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getDesktopSourceThumbnail", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Bad arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
     std::string sourceId = findString(params, "sourceId");
     if (sourceId.empty()) {
       result->Error("Bad Arguments", "Incorrect sourceId");
       return;
     }
-    const EncodableMap thumbnailSize = findMap(params, "thumbnailSize");
+    const EncodableMap& thumbnailSize = findMap(params, "thumbnailSize");
     if (!thumbnailSize.empty()) {
       int width = 0;
       int height = 0;
@@ -115,36 +122,38 @@ void FlutterWebRTC::HandleMethodCall(
     } else {
       result->Error("Bad Arguments", "Bad arguments received");
     }
-  } else if (method_call.method_name().compare("getSources") == 0) {
+  });
+  Register("getSources", [this](auto& call, auto result) {
     GetSources(std::move(result));
-  } else if (method_call.method_name().compare("selectAudioInput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
+  });
+  Register("selectAudioInput", [this](auto& call, auto result) {
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& deviceId = findString(params, "deviceId");
     SelectAudioInput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("selectAudioOutput") == 0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string deviceId = findString(params, "deviceId");
+  });
+  Register("selectAudioOutput", [this](auto& call, auto result) {
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& deviceId = findString(params, "deviceId");
     SelectAudioOutput(deviceId, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamGetTracks") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("mediaStreamGetTracks", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& streamId = findString(params, keys::kStreamId);
     MediaStreamGetTracks(streamId, std::move(result));
-  } else if (method_call.method_name().compare("createOffer") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("createOffer", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "constraints");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("createOfferFailed",
@@ -152,15 +161,16 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     CreateOffer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("createAnswer") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("createAnswer", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "constraints");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "constraints");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("createAnswerFailed",
@@ -168,15 +178,16 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     CreateAnswer(constraints, pc, std::move(result));
-  } else if (method_call.method_name().compare("addStream") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("addStream", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& streamId = findString(params, keys::kStreamId);
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
     if (!stream) {
@@ -190,15 +201,16 @@ void FlutterWebRTC::HandleMethodCall(
     }
     pc->AddStream(stream);
     result->Success();
-  } else if (method_call.method_name().compare("removeStream") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("removeStream", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string streamId = findString(params, "streamId");
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& streamId = findString(params, keys::kStreamId);
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
     if (!stream) {
@@ -213,15 +225,16 @@ void FlutterWebRTC::HandleMethodCall(
     }
     pc->RemoveStream(stream);
     result->Success();
-  } else if (method_call.method_name().compare("setLocalDescription") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("setLocalDescription", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "description");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("setLocalDescriptionFailed",
@@ -240,15 +253,16 @@ void FlutterWebRTC::HandleMethodCall(
     } else {
       result->Error("setLocalDescriptionFailed", "Invalid type or sdp");
     }
-  } else if (method_call.method_name().compare("setRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("setRemoteDescription", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "description");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("setRemoteDescriptionFailed",
@@ -267,15 +281,16 @@ void FlutterWebRTC::HandleMethodCall(
     } else {
       result->Error("setRemoteDescriptionFailed", "Invalid type or sdp");
     }
-  } else if (method_call.method_name().compare("addCandidate") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("addCandidate", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "candidate");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "candidate");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("addCandidateFailed",
@@ -300,29 +315,31 @@ void FlutterWebRTC::HandleMethodCall(
     } else {
       result->Error("addCandidateFailed", "Invalid candidate");
     }
-  } else if (method_call.method_name().compare("getStats") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getStats", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string track_id = findString(params, "trackId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const std::string& track_id = findString(params, keys::kTrackId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("getStatsFailed", "getStats() peerConnection is null");
       return;
     }
     GetStats(track_id, pc, std::move(result));
-  } else if (method_call.method_name().compare("createDataChannel") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("createDataChannel", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -331,19 +348,20 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string label = findString(params, "label");
-    const EncodableMap dataChannelDict = findMap(params, "dataChannelDict");
+    const std::string& label = findString(params, "label");
+    const EncodableMap& dataChannelDict = findMap(params, "dataChannelDict");
 
     CreateDataChannel(peerConnectionId, label, dataChannelDict, pc,
                       std::move(result));
-  } else if (method_call.method_name().compare("dataChannelSend") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("dataChannelSend", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("dataChannelSendFailed",
@@ -351,9 +369,9 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string dataChannelId = findString(params, "dataChannelId");
-    const std::string type = findString(params, "type");
-    const EncodableValue data = findEncodableValue(params, "data");
+    const std::string& dataChannelId = findString(params, "dataChannelId");
+    const std::string& type = findString(params, "type");
+    const EncodableValue& data = findEncodableValue(params, "data");
     RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
     if (data_channel == nullptr) {
       result->Error("dataChannelSendFailed",
@@ -361,15 +379,15 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     DataChannelSend(data_channel, type, data, std::move(result));
-  } else if (method_call.method_name().compare(
-                 "dataChannelGetBufferedAmount") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("dataChannelGetBufferedAmount", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("dataChannelGetBufferedAmountFailed",
@@ -377,7 +395,7 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string dataChannelId = findString(params, "dataChannelId");
+    const std::string& dataChannelId = findString(params, "dataChannelId");
     RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
     if (data_channel == nullptr) {
       result->Error("dataChannelGetBufferedAmountFailed",
@@ -385,14 +403,15 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     DataChannelGetBufferedAmount(data_channel, std::move(result));
-  } else if (method_call.method_name().compare("dataChannelClose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("dataChannelClose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("dataChannelCloseFailed",
@@ -400,7 +419,7 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string dataChannelId = findString(params, "dataChannelId");
+    const std::string& dataChannelId = findString(params, "dataChannelId");
     RTCDataChannel* data_channel = DataChannelForId(dataChannelId);
     if (data_channel == nullptr) {
       result->Error("dataChannelCloseFailed",
@@ -408,47 +427,47 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     DataChannelClose(data_channel, dataChannelId, std::move(result));
-  } else if (method_call.method_name().compare("streamDispose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("streamDispose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& stream_id = findString(params, keys::kStreamId);
     MediaStreamDispose(stream_id, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamTrackSetEnable") ==
-             0) {
-    if (!method_call.arguments()) {
+  });
+  Register("mediaStreamTrackSetEnable", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
-    const EncodableValue enable = findEncodableValue(params, "enabled");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& track_id = findString(params, keys::kTrackId);
+    const EncodableValue& enable = findEncodableValue(params, "enabled");
     RTCMediaTrack* track = MediaTrackForId(track_id);
     if (track != nullptr) {
       track->set_enabled(GetValue<bool>(enable));
     }
     result->Success();
-  } else if (method_call.method_name().compare("trackDispose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("trackDispose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& track_id = findString(params, keys::kTrackId);
     MediaStreamTrackDispose(track_id, std::move(result));
-  } else if (method_call.method_name().compare("restartIce") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("restartIce", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("restartIceFailed", "restartIce() peerConnection is null");
@@ -456,14 +475,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
     pc->RestartIce();
     result->Success();
-  } else if (method_call.method_name().compare("peerConnectionClose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("peerConnectionClose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("peerConnectionCloseFailed",
@@ -471,65 +491,82 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     RTCPeerConnectionClose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("peerConnectionDispose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("peerConnectionDispose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Success();
       return;
     }
     RTCPeerConnectionDispose(pc, peerConnectionId, std::move(result));
-  } else if (method_call.method_name().compare("createVideoRenderer") == 0) {
+  });
+  Register("createVideoRenderer", [this](auto& call, auto result) {
     CreateVideoRendererTexture(std::move(result));
-  } else if (method_call.method_name().compare("videoRendererDispose") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("videoRendererDispose", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
     int64_t texture_id = findLongInt(params, "textureId");
     VideoRendererDispose(texture_id, std::move(result));
-  } else if (method_call.method_name().compare("videoRendererSetSrcObject") ==
-             0) {
-    if (!method_call.arguments()) {
+  });
+  Register("videoRendererSetSrcObject", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string stream_id = findString(params, "streamId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& stream_id = findString(params, keys::kStreamId);
     int64_t texture_id = findLongInt(params, "textureId");
-    const std::string owner_tag = findString(params, "ownerTag");
-    const std::string track_id = findString(params, "trackId");
+    const std::string& owner_tag = findString(params, "ownerTag");
+    const std::string& track_id = findString(params, keys::kTrackId);
 
     VideoRendererSetSrcObject(texture_id, stream_id, owner_tag, track_id);
     result->Success();
-  } else if (method_call.method_name().compare(
-                 "mediaStreamTrackSwitchCamera") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("videoRendererSetOptions", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    int64_t texture_id = findLongInt(params, "textureId");
+    VideoRendererSetOptions(texture_id, params, std::move(result));
+  });
+  Register("videoRendererGetStats", [this](auto& call, auto result) {
+    EncodableMap params;
+    if (call.arguments()) {
+      params = GetValue<EncodableMap>(*call.arguments());
+    }
+    VideoRendererGetStats(params, std::move(result));
+  });
+  Register("mediaStreamTrackSwitchCamera", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string track_id = findString(params, "trackId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& track_id = findString(params, keys::kTrackId);
     MediaStreamTrackSwitchCamera(track_id, std::move(result));
-  } else if (method_call.method_name().compare("setVolume") == 0) {
-    auto args = method_call.arguments();
+  });
+  Register("setVolume", [this](auto& call, auto result) {
+    auto args = call.arguments();
     if (!args) {
       result->Error("Bad Arguments", "setVolume() Null arguments received");
       return;
     }
 
-    const EncodableMap params = GetValue<EncodableMap>(*args);
-    const std::string trackId = findString(params, "trackId");
+    const EncodableMap& params = GetValue<EncodableMap>(*args);
+    const std::string& trackId = findString(params, keys::kTrackId);
     const std::optional<double> volume = maybeFindDouble(params, "volume");
 
     if (trackId.empty()) {
@@ -564,15 +601,16 @@ void FlutterWebRTC::HandleMethodCall(
     audioTrack->SetVolume(volume.value());
 
     result->Success();
-  } else if (method_call.method_name().compare("getLocalDescription") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getLocalDescription", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "description");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("GetLocalDescription",
@@ -581,15 +619,16 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     GetLocalDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("getRemoteDescription") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getRemoteDescription", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap constraints = findMap(params, "description");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& constraints = findMap(params, "description");
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("GetRemoteDescription",
@@ -598,16 +637,16 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     GetRemoteDescription(pc, std::move(result));
-  } else if (method_call.method_name().compare("mediaStreamAddTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("mediaStreamAddTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
+    const std::string& streamId = findString(params, keys::kStreamId);
+    const std::string& trackId = findString(params, keys::kTrackId);
 
     scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
     if (stream == nullptr) {
@@ -631,16 +670,16 @@ void FlutterWebRTC::HandleMethodCall(
         renderer->SetVideoTrack(static_cast<RTCVideoTrack*>(track.get()));
       }
     }
-  } else if (method_call.method_name().compare("mediaStreamRemoveTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("mediaStreamRemoveTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string streamId = findString(params, "streamId");
-    const std::string trackId = findString(params, "trackId");
+    const std::string& streamId = findString(params, keys::kStreamId);
+    const std::string& trackId = findString(params, keys::kTrackId);
 
     scoped_refptr<RTCMediaStream> stream = MediaStreamForId(streamId);
     if (stream == nullptr) {
@@ -664,17 +703,18 @@ void FlutterWebRTC::HandleMethodCall(
         renderer->SetVideoTrack(nullptr);
       }
     }
-  } else if (method_call.method_name().compare("addTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("addTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string trackId = findString(params, "trackId");
-    const EncodableList streamIds = findList(params, "streamIds");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const std::string& trackId = findString(params, keys::kTrackId);
+    const EncodableList& streamIds = findList(params, keys::kStreamIds);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -688,22 +728,22 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     std::vector<std::string> ids;
-    for (EncodableValue value : streamIds) {
+    for (const EncodableValue& value : streamIds) {
       ids.push_back(GetValue<std::string>(value));
     }
 
     AddTrack(pc, track, ids, std::move(result));
-
-  } else if (method_call.method_name().compare("removeTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("removeTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string senderId = findString(params, "senderId");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const std::string& senderId = findString(params, "senderId");
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -712,18 +752,19 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     RemoveTrack(pc, senderId, std::move(result));
-
-  } else if (method_call.method_name().compare("addTransceiver") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("addTransceiver", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const EncodableMap transceiverInit = findMap(params, "transceiverInit");
-    const std::string mediaType = findString(params, "mediaType");
-    const std::string trackId = findString(params, "trackId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const EncodableMap& transceiverInit =
+        findMap(params, keys::kTransceiverInit);
+    const std::string& mediaType = findString(params, keys::kMediaType);
+    const std::string& trackId = findString(params, keys::kTrackId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -732,14 +773,15 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
     AddTransceiver(pc, trackId, mediaType, transceiverInit, std::move(result));
-  } else if (method_call.method_name().compare("getTransceivers") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getTransceivers", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -749,14 +791,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     GetTransceivers(pc, std::move(result));
-  } else if (method_call.method_name().compare("getReceivers") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getReceivers", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -765,15 +808,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     GetReceivers(pc, std::move(result));
-
-  } else if (method_call.method_name().compare("getSenders") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getSenders", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -782,14 +825,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     GetSenders(pc, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("rtpSenderSetTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -798,24 +842,25 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string trackId = findString(params, "trackId");
+    const std::string& trackId = findString(params, keys::kTrackId);
     RTCMediaTrack* track = MediaTrackForId(trackId);
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
     if (rtpSenderId.empty()) {
       result->Error("rtpSenderSetTrack",
                     "rtpSenderSetTrack() rtpSenderId is null or empty");
       return;
     }
     RtpSenderSetTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetStreams") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("rtpSenderSetStreams", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -824,32 +869,34 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const EncodableList encodableStreamIds = findList(params, "streamIds");
+    const EncodableList& encodableStreamIds =
+        findList(params, keys::kStreamIds);
     if (encodableStreamIds.empty()) {
       result->Error("rtpSenderSetStream",
                     "rtpSenderSetStream() streamId is null or empty");
       return;
     }
     std::vector<std::string> streamIds{};
-    for (EncodableValue value : encodableStreamIds) {
+    for (const EncodableValue& value : encodableStreamIds) {
       streamIds.push_back(GetValue<std::string>(value));
     }
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
     if (rtpSenderId.empty()) {
       result->Error("rtpSenderSetStream",
                     "rtpSenderSetStream() rtpSenderId is null or empty");
       return;
     }
     RtpSenderSetStream(pc, streamIds, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderReplaceTrack") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("rtpSenderReplaceTrack", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -858,24 +905,25 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string trackId = findString(params, "trackId");
+    const std::string& trackId = findString(params, keys::kTrackId);
     RTCMediaTrack* track = MediaTrackForId(trackId);
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
     if (rtpSenderId.empty()) {
       result->Error("rtpSenderReplaceTrack",
                     "rtpSenderReplaceTrack() rtpSenderId is null or empty");
       return;
     }
     RtpSenderReplaceTrack(pc, track, rtpSenderId, std::move(result));
-  } else if (method_call.method_name().compare("rtpSenderSetParameters") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("rtpSenderSetParameters", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -884,14 +932,14 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
     if (rtpSenderId.empty()) {
       result->Error("rtpSenderSetParameters",
                     "rtpSenderSetParameters() rtpSenderId is null or empty");
       return;
     }
 
-    const EncodableMap parameters = findMap(params, "parameters");
+    const EncodableMap& parameters = findMap(params, keys::kParameters);
     if (0 == parameters.size()) {
       result->Error("rtpSenderSetParameters",
                     "rtpSenderSetParameters() parameters is null or empty");
@@ -899,14 +947,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     RtpSenderSetParameters(pc, rtpSenderId, parameters, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverStop") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("rtpTransceiverStop", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -915,7 +964,7 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string transceiverId = findString(params, "transceiverId");
+    const std::string& transceiverId = findString(params, keys::kTransceiverId);
     if (transceiverId.empty()) {
       result->Error("rtpTransceiverStop",
                     "rtpTransceiverStop() transceiverId is null or empty");
@@ -923,42 +972,44 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     RtpTransceiverStop(pc, transceiverId, std::move(result));
-  } else if (method_call.method_name().compare(
-                 "rtpTransceiverGetCurrentDirection") == 0) {
-    if (!method_call.arguments()) {
-      result->Error("Bad Arguments", "Null constraints arguments received");
-      return;
-    }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-
-    RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
-    if (pc == nullptr) {
-      result->Error(
-          "rtpTransceiverGetCurrentDirection",
-          "rtpTransceiverGetCurrentDirection() peerConnection is null");
-      return;
-    }
-
-    const std::string transceiverId = findString(params, "transceiverId");
-    if (transceiverId.empty()) {
-      result->Error("rtpTransceiverGetCurrentDirection",
-                    "rtpTransceiverGetCurrentDirection() transceiverId is "
-                    "null or empty");
-      return;
-    }
-
-    RtpTransceiverGetCurrentDirection(pc, transceiverId, std::move(result));
-  } else if (method_call.method_name().compare("rtpTransceiverSetDirection") ==
-             0) {
-    if (!method_call.arguments()) {
+  });
+  Register(
+      "rtpTransceiverGetCurrentDirection", [this](auto& call, auto result) {
+        if (!call.arguments()) {
+          result->Error("Bad Arguments", "Null constraints arguments received");
+          return;
+        }
+        const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+        const std::string& peerConnectionId =
+            findString(params, keys::kPeerConnectionId);
+
+        RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
+        if (pc == nullptr) {
+          result->Error(
+              "rtpTransceiverGetCurrentDirection",
+              "rtpTransceiverGetCurrentDirection() peerConnection is null");
+          return;
+        }
+
+        const std::string& transceiverId =
+            findString(params, keys::kTransceiverId);
+        if (transceiverId.empty()) {
+          result->Error("rtpTransceiverGetCurrentDirection",
+                        "rtpTransceiverGetCurrentDirection() transceiverId is "
+                        "null or empty");
+          return;
+        }
+
+        RtpTransceiverGetCurrentDirection(pc, transceiverId, std::move(result));
+      });
+  Register("rtpTransceiverSetDirection", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -967,7 +1018,7 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string transceiverId = findString(params, "transceiverId");
+    const std::string& transceiverId = findString(params, keys::kTransceiverId);
     if (transceiverId.empty()) {
       result->Error("rtpTransceiverSetDirection",
                     "rtpTransceiverSetDirection() transceiverId is "
@@ -975,7 +1026,7 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string direction = findString(params, "direction");
+    const std::string& direction = findString(params, keys::kDirection);
     if (transceiverId.empty()) {
       result->Error("rtpTransceiverSetDirection",
                     "rtpTransceiverSetDirection() direction is null or empty");
@@ -983,14 +1034,15 @@ void FlutterWebRTC::HandleMethodCall(
     }
 
     RtpTransceiverSetDirection(pc, transceiverId, direction, std::move(result));
-  } else if (method_call.method_name().compare("setConfiguration") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("setConfiguration", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -999,52 +1051,137 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const EncodableMap configuration = findMap(params, "configuration");
+    const EncodableMap& configuration = findMap(params, "configuration");
     if (configuration.empty()) {
       result->Error("setConfiguration",
                     "setConfiguration() configuration is null or empty");
       return;
     }
     SetConfiguration(pc, configuration, std::move(result));
-  } else if (method_call.method_name().compare("captureFrame") == 0) {
-    if (!method_call.arguments()) {
+  });
+  auto capture_frame = [this](auto& call, auto result) {
+    // Both encode the next frame of a track; captureFrame saves it to "path"
+    // and captureFrameToBytes returns it.
+    const std::string& method = call.method_name();
+    bool to_bytes = method.compare("captureFrameToBytes") == 0;
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string path = findString(params, "path");
-    if (path.empty()) {
-      result->Error("captureFrame", "captureFrame() path is null or empty");
+    const std::string path = to_bytes ? "" : findString(params, "path");
+    if (!to_bytes && path.empty()) {
+      result->Error(method, method + "() path is null or empty");
       return;
     }
 
-    const std::string trackId = findString(params, "trackId");
+    const std::string& trackId = findString(params, keys::kTrackId);
     RTCMediaTrack* track = MediaTrackForId(trackId);
     if (nullptr == track) {
-      result->Error("captureFrame", "captureFrame() track is null");
+      result->Error(method, method + "() track is null");
       return;
     }
     std::string kind = track->kind().std_string();
     if (0 != kind.compare("video")) {
-      result->Error("captureFrame", "captureFrame() track not is video track");
+      result->Error(method, method + "() track not is video track");
+      return;
+    }
+    // PNG unless "format" says otherwise.
+    ImageFormat format = ImageFormat::kPNG;
+    const std::string& format_name = findString(params, "format");
+    if (!format_name.empty() && !ParseImageFormat(format_name, &format)) {
+      result->Error(method, method + "() unsupported format " + format_name);
+      return;
+    }
+    // JPEG quality, 90 by default.
+    int quality = findInt(params, "quality");
+    if (quality <= 0 || quality > 100) {
+      quality = 90;
+    }
+    // Optional bounds to scale the frame down to, keeping its aspect ratio.
+    int max_width = findInt(params, "width");
+    int max_height = findInt(params, "height");
+    // Milliseconds to wait for the next frame, 5 s by default.
+    int timeout = findInt(params, "timeout");
+    if (timeout <= 0) {
+      timeout = 5000;
+    }
+    CaptureFrame(reinterpret_cast<RTCVideoTrack*>(track), path, format,
+                 quality, max_width > 0 ? max_width : 0,
+                 max_height > 0 ? max_height : 0,
+                 std::chrono::milliseconds(timeout), std::move(result));
+  };
+  Register("captureFrame", capture_frame);
+  Register("captureFrameToBytes", capture_frame);
+  Register("videoTrackStartFrameTap", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    CaptureFrame(reinterpret_cast<RTCVideoTrack*>(track), path,
-                 std::move(result));
-
-  } else if (method_call.method_name().compare("createLocalMediaStream") == 0) {
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& trackId = findString(params, keys::kTrackId);
+    RTCMediaTrack* track = MediaTrackForId(trackId);
+    if (nullptr == track || track->kind().std_string() != "video") {
+      result->Error("videoTrackStartFrameTap",
+                    "videoTrackStartFrameTap() video track not found");
+      return;
+    }
+    StartFrameTap(reinterpret_cast<RTCVideoTrack*>(track), params,
+                  std::move(result));
+  });
+  Register("videoTrackStopFrameTap", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    StopFrameTap(findString(params, "tapId"), std::move(result));
+  });
+  Register("videoTrackStartDump", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    StartFrameDump(params, std::move(result));
+  });
+  Register("videoTrackStopDump", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    StopFrameDump(findString(params, keys::kTrackId), std::move(result));
+  });
+  Register("startRecordToFile", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    StartRecordToFile(params, std::move(result));
+  });
+  Register("stopRecordToFile", [this](auto& call, auto result) {
+    if (!call.arguments()) {
+      result->Error("Bad Arguments", "Null constraints arguments received");
+      return;
+    }
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    StopRecordToFile(findLongInt(params, "recorderId"), std::move(result));
+  });
+  Register("createLocalMediaStream", [this](auto& call, auto result) {
     CreateLocalMediaStream(std::move(result));
-  } else if (method_call.method_name().compare("canInsertDtmf") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("canInsertDtmf", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -1062,16 +1199,17 @@ void FlutterWebRTC::HandleMethodCall(
     bool canInsertDtmf = dtmfSender->CanInsertDtmf();
 
     result->Success(EncodableValue(canInsertDtmf));
-  } else if (method_call.method_name().compare("sendDtmf") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("sendDtmf", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
-    const std::string rtpSenderId = findString(params, "rtpSenderId");
-    const std::string tone = findString(params, "tone");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
+    const std::string& rtpSenderId = findString(params, keys::kRtpSenderId);
+    const std::string& tone = findString(params, "tone");
     int duration = findInt(params, "duration");
     int gap = findInt(params, "gap");
 
@@ -1092,17 +1230,16 @@ void FlutterWebRTC::HandleMethodCall(
     dtmfSender->InsertDtmf(tone, duration, gap);
 
     result->Success();
-  } else if (method_call.method_name().compare("getRtpSenderCapabilities") ==
-             0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getRtpSenderCapabilities", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
     RTCMediaType mediaType = RTCMediaType::AUDIO;
-    const std::string kind = findString(params, "kind");
+    const std::string& kind = findString(params, "kind");
     if (0 == kind.compare("video")) {
       mediaType = RTCMediaType::VIDEO;
     } else if (0 == kind.compare("audio")) {
@@ -1131,13 +1268,12 @@ void FlutterWebRTC::HandleMethodCall(
     map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
 
     result->Success(EncodableValue(map));
-  } else if (method_call.method_name().compare("getRtpReceiverCapabilities") ==
-             0) {
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+  });
+  Register("getRtpReceiverCapabilities", [this](auto& call, auto result) {
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
     RTCMediaType mediaType = RTCMediaType::AUDIO;
-    const std::string kind = findString(params, "kind");
+    const std::string& kind = findString(params, "kind");
     if (0 == kind.compare("video")) {
       mediaType = RTCMediaType::VIDEO;
     } else if (0 == kind.compare("audio")) {
@@ -1166,14 +1302,15 @@ void FlutterWebRTC::HandleMethodCall(
     map[EncodableValue("fecMechanisms")] = EncodableValue(EncodableList());
 
     result->Success(EncodableValue(map));
-  } else if (method_call.method_name().compare("setCodecPreferences") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("setCodecPreferences", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
       result->Error("setCodecPreferences",
@@ -1181,29 +1318,30 @@ void FlutterWebRTC::HandleMethodCall(
       return;
     }
 
-    const std::string transceiverId = findString(params, "transceiverId");
+    const std::string& transceiverId = findString(params, keys::kTransceiverId);
     if (transceiverId.empty()) {
       result->Error("setCodecPreferences",
                     "setCodecPreferences() transceiverId is null or empty");
       return;
     }
 
-    const EncodableList codecs = findList(params, "codecs");
+    const EncodableList& codecs = findList(params, "codecs");
     if (codecs.empty()) {
       result->Error("Bad Arguments", "Codecs is required");
       return;
     }
     RtpTransceiverSetCodecPreferences(pc, transceiverId, codecs,
                                       std::move(result));
-  } else if (method_call.method_name().compare("getSignalingState") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getSignalingState", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -1215,15 +1353,16 @@ void FlutterWebRTC::HandleMethodCall(
     state[EncodableValue("state")] =
         signalingStateString(pc->signaling_state());
     result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getIceGatheringState") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getIceGatheringState", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -1235,15 +1374,16 @@ void FlutterWebRTC::HandleMethodCall(
     state[EncodableValue("state")] =
         iceGatheringStateString(pc->ice_gathering_state());
     result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getIceConnectionState") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getIceConnectionState", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -1255,15 +1395,16 @@ void FlutterWebRTC::HandleMethodCall(
     state[EncodableValue("state")] =
         iceConnectionStateString(pc->ice_connection_state());
     result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("getConnectionState") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("getConnectionState", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Null constraints arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
 
-    const std::string peerConnectionId = findString(params, "peerConnectionId");
+    const std::string& peerConnectionId =
+        findString(params, keys::kPeerConnectionId);
 
     RTCPeerConnection* pc = PeerConnectionForId(peerConnectionId);
     if (pc == nullptr) {
@@ -1275,28 +1416,68 @@ void FlutterWebRTC::HandleMethodCall(
     state[EncodableValue("state")] =
         peerConnectionStateString(pc->peer_connection_state());
     result->Success(EncodableValue(state));
-  } else if (method_call.method_name().compare("setLogSeverity") == 0) {
-    if (!method_call.arguments()) {
+  });
+  Register("setLogSeverity", [this](auto& call, auto result) {
+    if (!call.arguments()) {
       result->Error("Bad Arguments", "Bad arguments received");
       return;
     }
-    const EncodableMap params =
-        GetValue<EncodableMap>(*method_call.arguments());
+    const EncodableMap& params = GetValue<EncodableMap>(*call.arguments());
     std::string severityStr = findString(params, "severity");
     if (severityStr.empty() == false) {
       RTCLoggingSeverity severity = str2LogSeverity(severityStr);
       initLoggerCallback(severity);
     }
-  } else {
-    if (HandleFrameCryptorMethodCall(method_call, std::move(result), &result)) {
-      return;
-    } else if (HandleDataPacketCryptorMethodCall(method_call, std::move(result),
-                                                 &result)) {
-      return;
-    } else {
-      result->NotImplemented();
+    result->Success();
+  });
+  Register("getMethodStats", [this](auto& call, auto result) {
+    result->Success(EncodableValue(MethodStats()));
+  });
+  Register("getEventChannelStats", [this](auto& call, auto result) {
+    result->Success(EncodableValue(EventChannelStats()));
+  });
+  RegisterWithParams("executeBatch", [this](auto& params, auto result) {
+    DispatchBatch(findList(params, "calls"), std::move(result));
+  });
+  RegisterFrameCryptorMethods(this);
+  RegisterDataPacketCryptorMethods(this);
+}
+
+EncodableMap FlutterWebRTC::EventChannelStats() {
+  auto channel_stats = [](const EventChannelProxy* channel) {
+    EncodableMap stats;
+    stats[EncodableValue("queued")] =
+        EncodableValue(static_cast<int64_t>(channel->queued_events()));
+    stats[EncodableValue("dropped")] =
+        EncodableValue(static_cast<int64_t>(channel->dropped_events()));
+    return EncodableValue(stats);
+  };
+  EncodableMap peer_connections;
+  for (auto& it : peerconnection_observers_) {
+    peer_connections[EncodableValue(it.first)] =
+        channel_stats(it.second->event_channel());
+  }
+  EncodableMap data_channels;
+  for (auto& it : data_channel_observers_) {
+    data_channels[EncodableValue(it.first)] =
+        channel_stats(it.second->event_channel());
+  }
+  EncodableMap renderers;
+  for (auto& it : renders_) {
+    if (it.second->event_channel()) {
+      renderers[EncodableValue(it.first)] =
+          channel_stats(it.second->event_channel());
     }
   }
+
+  EncodableMap stats;
+  if (event_channel()) {
+    stats[EncodableValue("plugin")] = channel_stats(event_channel());
+  }
+  stats[EncodableValue("peerConnections")] = EncodableValue(peer_connections);
+  stats[EncodableValue("dataChannels")] = EncodableValue(data_channels);
+  stats[EncodableValue("renderers")] = EncodableValue(renderers);
+  return stats;
 }
 
 void FlutterWebRTC::initLoggerCallback(RTCLoggingSeverity severity) {
@@ -1,6 +1,7 @@
 #include "flutter_webrtc_base.h"
 
 #include "flutter_data_channel.h"
+#include "flutter_frame_capturer.h"
 #include "flutter_peerconnection.h"
 
 #include "helper.h"
@@ -24,6 +25,8 @@ FlutterWebRTCBase::FlutterWebRTCBase(BinaryMessenger* messenger,
 }
 
 FlutterWebRTCBase::~FlutterWebRTCBase() {
+  // Pending captures still hold tracks, so cancel them before libwebrtc goes.
+  frame_capture_worker_.reset();
   LibWebRTC::Terminate();
 }
 
@@ -31,6 +34,13 @@ EventChannelProxy* FlutterWebRTCBase::event_channel() {
   return event_channel_ ? event_channel_.get() : nullptr;
 }
 
+FrameCaptureWorker* FlutterWebRTCBase::frame_capture_worker() {
+  if (!frame_capture_worker_) {
+    frame_capture_worker_.reset(new FrameCaptureWorker());
+  }
+  return frame_capture_worker_.get();
+}
+
 std::string FlutterWebRTCBase::GenerateUUID() {
   return libwebrtc::Helper::CreateRandomUuid().std_string();
 }
@@ -133,10 +143,10 @@ void FlutterWebRTCBase::ParseConstraints(
     const EncodableMap& src,
     scoped_refptr<RTCMediaConstraints> mediaConstraints,
     ParseConstraintType type /*= kMandatory*/) {
-  for (auto kv : src) {
-    EncodableValue k = kv.first;
-    EncodableValue v = kv.second;
-    std::string key = GetValue<std::string>(k);
+  for (const auto& kv : src) {
+    const EncodableValue& k = kv.first;
+    const EncodableValue& v = kv.second;
+    const std::string& key = GetValue<std::string>(k);
     std::string value;
     if (TypeIs<EncodableList>(v) || TypeIs<EncodableMap>(v)) {
     } else if (TypeIs<std::string>(v)) {
@@ -171,7 +181,7 @@ scoped_refptr<RTCMediaConstraints> FlutterWebRTCBase::ParseMediaConstraints(
 
   if (constraints.find(EncodableValue("mandatory")) != constraints.end()) {
     auto it = constraints.find(EncodableValue("mandatory"));
-    const EncodableMap mandatory = GetValue<EncodableMap>(it->second);
+    const EncodableMap& mandatory = GetValue<EncodableMap>(it->second);
     ParseConstraints(mandatory, media_constraints, kMandatory);
   } else {
     // Log.d(TAG, "mandatory constraints are not a map");
@@ -179,12 +189,12 @@ scoped_refptr<RTCMediaConstraints> FlutterWebRTCBase::ParseMediaConstraints(
 
   auto it = constraints.find(EncodableValue("optional"));
   if (it != constraints.end()) {
-    const EncodableValue optional = it->second;
+    const EncodableValue& optional = it->second;
     if (TypeIs<EncodableMap>(optional)) {
       ParseConstraints(GetValue<EncodableMap>(optional), media_constraints,
                        kOptional);
     } else if (TypeIs<EncodableList>(optional)) {
-      const EncodableList list = GetValue<EncodableList>(optional);
+      const EncodableList& list = GetValue<EncodableList>(optional);
       for (size_t i = 0; i < list.size(); i++) {
         ParseConstraints(GetValue<EncodableMap>(list[i]), media_constraints,
                          kOptional);
@@ -202,7 +212,8 @@ bool FlutterWebRTCBase::CreateIceServers(const EncodableList& iceServersArray,
   size_t size = iceServersArray.size();
   for (size_t i = 0; i < size; i++) {
     IceServer& ice_server = ice_servers[i];
-    EncodableMap iceServerMap = GetValue<EncodableMap>(iceServersArray[i]);
+    const EncodableMap& iceServerMap =
+        GetValue<EncodableMap>(iceServersArray[i]);
 
     if (iceServerMap.find(EncodableValue("username")) != iceServerMap.end()) {
       ice_server.username = GetValue<std::string>(
@@ -223,10 +234,10 @@ bool FlutterWebRTCBase::CreateIceServers(const EncodableList& iceServersArray,
         ice_server.uri = GetValue<std::string>(it->second);
       }
       if (TypeIs<EncodableList>(it->second)) {
-        const EncodableList urls = GetValue<EncodableList>(it->second);
-        for (auto url : urls) {
+        const EncodableList& urls = GetValue<EncodableList>(it->second);
+        for (const auto& url : urls) {
           if (TypeIs<EncodableMap>(url)) {
-            const EncodableMap map = GetValue<EncodableMap>(url);
+            const EncodableMap& map = GetValue<EncodableMap>(url);
             std::string value;
             auto it2 = map.find(EncodableValue("url"));
             if (it2 != map.end()) {
@@ -246,7 +257,7 @@ bool FlutterWebRTCBase::ParseRTCConfiguration(const EncodableMap& map,
                                               RTCConfiguration& conf) {
   auto it = map.find(EncodableValue("iceServers"));
   if (it != map.end()) {
-    const EncodableList iceServersArray = GetValue<EncodableList>(it->second);
+    const EncodableList& iceServersArray = GetValue<EncodableList>(it->second);
     CreateIceServers(iceServersArray, conf.ice_servers);
   }
   // iceTransportPolicy (public API)
@@ -18,6 +18,8 @@ export 'src/native/utils.dart'
     if (dart.library.js_interop) 'src/web/utils.dart';
 export 'src/native/adapter_type.dart';
 export 'src/native/camera_utils.dart';
+export 'src/native/media_stream_track_impl.dart';
+export 'src/native/video_frame_tap.dart';
 export 'src/native/audio_management.dart';
 export 'src/native/android/audio_configuration.dart';
 export 'src/native/ios/audio_configuration.dart';
@@ -26,3 +26,13 @@ class FlutterWebRTCEventChannel {
     }
   }
 }
+
+/// Listens to [channel] with native event batching requested. The Windows and
+/// Linux implementations then send bursts of events as a single list, which
+/// is flattened here, so listeners still see one event at a time. Platforms
+/// that ignore the request send events one by one, which pass through as is.
+Stream<dynamic> receiveBatchedBroadcastStream(EventChannel channel) {
+  return channel
+      .receiveBroadcastStream(const <String, dynamic>{'batchEvents': true})
+      .expand((event) => event is List ? event : [event]);
+}
@@ -7,6 +7,7 @@ import 'package:webrtc_interface/webrtc_interface.dart';
 
 import '../helper.dart';
 import 'utils.dart';
+import 'video_frame_tap.dart';
 
 class MediaStreamTrackNative extends MediaStreamTrack {
   MediaStreamTrackNative(this._trackId, this._label, this._kind, this._enabled,
@@ -85,6 +86,9 @@ class MediaStreamTrackNative extends MediaStreamTrack {
 
   @override
   Future<ByteBuffer> captureFrame() async {
+    if (WebRTC.platformIsWindows || WebRTC.platformIsLinux) {
+      return (await captureFrameToBytes()).buffer;
+    }
     var filePath = await getTemporaryDirectory();
     await WebRTC.invokeMethod(
       'captureFrame',
@@ -99,6 +103,68 @@ class MediaStreamTrackNative extends MediaStreamTrack {
         .then((value) => value.buffer);
   }
 
+  /// Encodes the next frame of this video track and returns the image bytes
+  /// without going through a file. The frame is scaled down to fit within
+  /// [width] x [height] when given. [format] is 'png', 'jpeg' or 'qoi';
+  /// [quality] (1-100) applies to JPEG only.
+  ///
+  /// Only implemented on Windows and Linux.
+  Future<Uint8List> captureFrameToBytes(
+      {int? width, int? height, String format = 'png', int? quality}) async {
+    final response = await WebRTC.invokeMethod(
+      'captureFrameToBytes',
+      <String, dynamic>{
+        'trackId': _trackId,
+        'peerConnectionId': _peerConnectionId,
+        'format': format,
+        if (width != null) 'width': width,
+        if (height != null) 'height': height,
+        if (quality != null) 'quality': quality,
+      },
+    );
+    return response as Uint8List;
+  }
+
+  /// Streams frames of this video track at up to [fps], scaled to [width] x
+  /// [height]. See [VideoFrameTap.start].
+  ///
+  /// Only implemented on Windows and Linux.
+  Future<VideoFrameTap> startFrameTap(
+          {double fps = 1,
+          int? width,
+          int? height,
+          VideoFrameTapFormat format = VideoFrameTapFormat.rgb}) =>
+      VideoFrameTap.start(_trackId,
+          fps: fps, width: width, height: height, format: format);
+
+  /// Dumps the frames of this video track, as they reach the renderers, to a
+  /// Y4M file at [path] for offline quality analysis, with their arrival
+  /// times in `<path>.timestamps`. Frames are written as decoded, without
+  /// applying their rotation; each change of frame size starts a new file
+  /// next to [path], named `<name>.<n><extension>`. Stops accepting frames
+  /// after [maxFrames] when given.
+  ///
+  /// Only implemented on Windows and Linux.
+  Future<void> startDump(String path, {int? maxFrames}) =>
+      WebRTC.invokeMethod(
+        'videoTrackStartDump',
+        <String, dynamic>{
+          'trackId': _trackId,
+          'path': path,
+          if (maxFrames != null) 'maxFrames': maxFrames,
+        },
+      );
+
+  /// Stops the dump started by [startDump] and returns the number of
+  /// `frames` written and `dropped`, and of Y4M files (`segments`).
+  Future<Map<String, int>> stopDump() async {
+    final response = await WebRTC.invokeMethod(
+      'videoTrackStopDump',
+      <String, dynamic>{'trackId': _trackId},
+    );
+    return Map<String, int>.from(response);
+  }
+
   @override
   Future<void> applyConstraints([Map<String, dynamic>? constraints]) {
     if (constraints == null) return Future.value();
@@ -4,6 +4,7 @@ import 'package:flutter/services.dart';
 
 import 'package:webrtc_interface/webrtc_interface.dart';
 
+import 'event_channel.dart';
 import 'utils.dart';
 
 final _typeStringToMessageType = <String, MessageType>{
@@ -22,8 +23,8 @@ class RTCDataChannelNative extends RTCDataChannel {
     if (state != null) {
       _state = state;
     }
-    _eventSubscription = _eventChannelFor(_peerConnectionId, _flutterId)
-        .receiveBroadcastStream()
+    _eventSubscription = receiveBatchedBroadcastStream(
+            _eventChannelFor(_peerConnectionId, _flutterId))
         .listen(eventListener, onError: errorListener);
   }
   final String _peerConnectionId;
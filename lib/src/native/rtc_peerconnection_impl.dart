@@ -4,6 +4,7 @@ import 'package:flutter/services.dart';
 
 import 'package:webrtc_interface/webrtc_interface.dart';
 
+import 'event_channel.dart';
 import 'media_stream_impl.dart';
 import 'media_stream_track_impl.dart';
 import 'rtc_data_channel_impl.dart';
@@ -18,9 +19,9 @@ import 'utils.dart';
  */
 class RTCPeerConnectionNative extends RTCPeerConnection {
   RTCPeerConnectionNative(this._peerConnectionId, this._configuration) {
-    _eventSubscription = _eventChannelFor(_peerConnectionId)
-        .receiveBroadcastStream()
-        .listen(eventListener, onError: errorListener);
+    _eventSubscription =
+        receiveBatchedBroadcastStream(_eventChannelFor(_peerConnectionId))
+            .listen(eventListener, onError: errorListener);
   }
 
   // private:
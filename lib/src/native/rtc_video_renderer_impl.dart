@@ -93,6 +93,37 @@ class RTCVideoRenderer extends ValueNotifier<RTCVideoValue>
     }
   }
 
+  /// On Windows and Linux frames are scaled down to the size the texture is
+  /// drawn at. Pass `true` to always render frames at their source resolution.
+  Future<void> setFullResolution(bool fullResolution) =>
+      _setOptions({'fullResolution': fullResolution});
+
+  /// Caps how many frames per second are rendered into the texture on
+  /// Windows and Linux. Extra frames are dropped before they are converted.
+  /// Pass `null` or `0` to render every frame.
+  Future<void> setMaxFrameRate(double? maxFrameRate) =>
+      _setOptions({'maxFrameRate': maxFrameRate ?? 0.0});
+
+  /// Frame counters and conversion/latency histograms of this texture, see
+  /// `videoRendererGetStats`. Only implemented on Windows and Linux; other
+  /// platforms return an empty map.
+  Future<Map<String, dynamic>> getStats() async {
+    if (!WebRTC.platformIsWindows && !WebRTC.platformIsLinux) return {};
+    if (_textureId == null) throw 'Call initialize before getting stats';
+    final response = await WebRTC.invokeMethod(
+        'videoRendererGetStats', <String, dynamic>{'textureId': _textureId});
+    return Map<String, dynamic>.from(response['texture'] ?? {});
+  }
+
+  Future<void> _setOptions(Map<String, dynamic> options) async {
+    if (!WebRTC.platformIsWindows && !WebRTC.platformIsLinux) return;
+    if (_textureId == null) throw 'Call initialize before setting options';
+    await WebRTC.invokeMethod('videoRendererSetOptions', <String, dynamic>{
+      'textureId': _textureId,
+      ...options,
+    });
+  }
+
   @override
   Future<void> dispose() async {
     if (_disposed) return;
@@ -73,4 +73,56 @@ class WebRTC {
       initialized = true;
     }
   }
+
+  /// Call counts and latency histograms for every native method called so
+  /// far, keyed by method name. Each entry has a `handler` histogram (time
+  /// spent on the platform thread) and a `reply` histogram (time until the
+  /// result arrived), both with `count`, `meanMs`, `maxMs`, `bucketBoundsMs`
+  /// and `buckets`.
+  ///
+  /// Only implemented on Windows and Linux.
+  static Future<Map<String, dynamic>> getMethodStats() async {
+    final response = await _channel.invokeMethod<Map>('getMethodStats');
+    return Map<String, dynamic>.from(response ?? {});
+  }
+
+  /// How many events each native event channel buffered while no one
+  /// listened (`queued`), and how many of those it `dropped` because its
+  /// buffer was full or coalesced with a newer event. Keyed by channel:
+  /// `plugin` for the plugin-wide channel, then `peerConnections`,
+  /// `dataChannels` and `renderers`, each keyed by id.
+  ///
+  /// Only implemented on Windows and Linux.
+  static Future<Map<String, dynamic>> getEventChannelStats() async {
+    final response = await _channel.invokeMethod<Map>('getEventChannelStats');
+    return Map<String, dynamic>.from(response ?? {});
+  }
+
+  /// Invokes [calls] in order in a single platform-channel round trip and
+  /// returns their results in the same order. A call that fails does not
+  /// fail the batch; its slot holds the [PlatformException] instead, or a
+  /// [MissingPluginException] if the method is not implemented.
+  ///
+  /// Only implemented on Windows and Linux.
+  static Future<List<Object?>> executeBatch(List<MethodCall> calls) async {
+    final response = await invokeMethod<List, dynamic>('executeBatch', {
+      'calls': [
+        for (final call in calls)
+          {'method': call.method, 'args': call.arguments},
+      ],
+    });
+    return [
+      for (final reply in response ?? const [])
+        if ((reply as Map).containsKey('error'))
+          reply['error'] == 'notImplemented'
+              ? MissingPluginException(reply['message'] as String?)
+              : PlatformException(
+                  code: reply['error'] as String,
+                  message: reply['message'] as String?,
+                  details: reply['details'],
+                )
+        else
+          reply['result'],
+    ];
+  }
 }
@@ -0,0 +1,100 @@
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
+
+import 'utils.dart';
+
+enum VideoFrameTapFormat { rgb, y }
+
+/// A frame delivered by a [VideoFrameTap].
+class TappedVideoFrame {
+  TappedVideoFrame(this.width, this.height, this.format, this.sequence,
+      this.timestampUs, this.pixels);
+
+  /// Parses a message sent by the native tap: a 24-byte little-endian header
+  /// (width, height, format, sequence number, capture time) followed by the
+  /// pixels.
+  factory TappedVideoFrame.fromMessage(ByteData message) {
+    return TappedVideoFrame(
+      message.getUint32(0, Endian.little),
+      message.getUint32(4, Endian.little),
+      VideoFrameTapFormat.values[message.getUint8(8)],
+      message.getUint32(12, Endian.little),
+      message.getInt64(16, Endian.little),
+      message.buffer.asUint8List(message.offsetInBytes + _headerSize,
+          message.lengthInBytes - _headerSize),
+    );
+  }
+
+  static const int _headerSize = 24;
+
+  final int width;
+  final int height;
+  final VideoFrameTapFormat format;
+
+  /// Advances for every frame that passes the rate cap; gaps are frames
+  /// skipped because Dart had not taken the previous one yet.
+  final int sequence;
+
+  /// Capture time in microseconds since the Unix epoch.
+  final int timestampUs;
+
+  /// Tightly packed rows: 3 bytes per pixel for [VideoFrameTapFormat.rgb],
+  /// 1 for [VideoFrameTapFormat.y].
+  final Uint8List pixels;
+}
+
+/// Streams frames of a video track at a capped rate and size, for on-device
+/// analysis.
+///
+/// Only implemented on Windows and Linux.
+class VideoFrameTap {
+  VideoFrameTap._(this._tapId, this._channel);
+
+  /// Starts tapping the video track [trackId]. Frames are scaled to [width] x
+  /// [height]; with only one of them the other follows the aspect ratio.
+  /// [fps] caps the delivery rate, 0 delivers every frame.
+  static Future<VideoFrameTap> start(String trackId,
+      {double fps = 1,
+      int? width,
+      int? height,
+      VideoFrameTapFormat format = VideoFrameTapFormat.rgb}) async {
+    final response = await WebRTC.invokeMethod(
+      'videoTrackStartFrameTap',
+      <String, dynamic>{
+        'trackId': trackId,
+        'fps': fps.toDouble(),
+        'format': format.name,
+        if (width != null) 'width': width,
+        if (height != null) 'height': height,
+      },
+    );
+    final tap = VideoFrameTap._(response['tapId'], response['channel']);
+    ServicesBinding.instance.defaultBinaryMessenger
+        .setMessageHandler(tap._channel, (ByteData? message) async {
+      if (message != null) {
+        tap._frames.add(TappedVideoFrame.fromMessage(message));
+      }
+      return null;
+    });
+    return tap;
+  }
+
+  final String _tapId;
+  final String _channel;
+  final StreamController<TappedVideoFrame> _frames =
+      StreamController.broadcast();
+
+  Stream<TappedVideoFrame> get frames => _frames.stream;
+
+  Future<void> stop() async {
+    ServicesBinding.instance.defaultBinaryMessenger
+        .setMessageHandler(_channel, null);
+    await WebRTC.invokeMethod(
+      'videoTrackStopFrameTap',
+      <String, dynamic>{'tapId': _tapId},
+    );
+    await _frames.close();
+  }
+}
@@ -1,31 +1,102 @@
 #include "task_runner_linux.h"
 
-#include <glib.h>
-
 namespace flutter_webrtc_plugin {
 
-void TaskRunnerLinux::EnqueueTask(TaskClosure task) {
-  {
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    tasks_.push(std::move(task));
+TaskRunnerLinux::TaskQueue::TaskQueue() : head_(&stub_), tail_(&stub_) {}
+
+TaskRunnerLinux::TaskQueue::~TaskQueue() {
+  while (Node* node = PopNode()) {
+    delete node;
+  }
+}
+
+void TaskRunnerLinux::TaskQueue::Push(TaskClosure task) {
+  Node* node = new Node();
+  node->task = std::move(task);
+  PushNode(node);
+}
+
+bool TaskRunnerLinux::TaskQueue::Pop(TaskClosure* task) {
+  Node* node = PopNode();
+  if (!node) {
+    return false;
+  }
+  *task = std::move(node->task);
+  delete node;
+  return true;
+}
+
+void TaskRunnerLinux::TaskQueue::PushNode(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+}
+
+TaskRunnerLinux::TaskQueue::Node* TaskRunnerLinux::TaskQueue::PopNode() {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire)) {
+    // A producer has swapped in a new head but not linked it yet.
+    return nullptr;
   }
+  // |tail| is the last node; put the stub behind it so it can be popped.
+  PushNode(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+void TaskRunnerLinux::EnqueueTask(TaskClosure task, TaskPriority priority) {
+  lanes_[static_cast<int>(priority)].Push(std::move(task));
 
+  if (pending_.fetch_add(1, std::memory_order_acq_rel) != 0) {
+    // The idle source is already scheduled, or running and will see this
+    // task before it removes itself.
+    return;
+  }
   GMainContext* context = g_main_context_default();
   if (context) {
-    g_main_context_invoke(
-        context,
-        [](gpointer user_data)  -> gboolean {
-          TaskRunnerLinux* runner = static_cast<TaskRunnerLinux*>(user_data);
-          std::lock_guard<std::mutex> lock(runner->tasks_mutex_);
-          while (!runner->tasks_.empty()) {
-            TaskClosure task = std::move(runner->tasks_.front());
-            runner->tasks_.pop();
-            task();
-          }
-          return G_SOURCE_REMOVE;
-        },
-        this);
+    GSource* source = g_idle_source_new();
+    g_source_set_priority(source, G_PRIORITY_DEFAULT);
+    g_source_set_callback(source, RunTasks, this, nullptr);
+    g_source_attach(source, context);
+    g_source_unref(source);
+  }
+}
+
+gboolean TaskRunnerLinux::RunTasks(gpointer user_data) {
+  TaskRunnerLinux* runner = static_cast<TaskRunnerLinux*>(user_data);
+  int64_t ran = 0;
+  for (int lane = 0; lane < kTaskPriorityCount; lane++) {
+    TaskClosure task;
+    for (int i = 0; i < kTaskPriorityBudgets[lane]; i++) {
+      if (!runner->lanes_[lane].Pop(&task)) {
+        break;
+      }
+      task();
+      ran++;
+    }
+  }
+  if (runner->pending_.fetch_sub(ran, std::memory_order_acq_rel) != ran) {
+    // Tasks are left over the budgets, or still being linked in.
+    return G_SOURCE_CONTINUE;
   }
+  return G_SOURCE_REMOVE;
 }
 
 }  // namespace flutter_webrtc_plugin
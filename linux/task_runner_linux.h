@@ -1,26 +1,67 @@
 #ifndef PACKAGES_FLUTTER_WEBRTC_LINUX_TASK_RUNNER_LINUX_H_
 #define PACKAGES_FLUTTER_WEBRTC_LINUX_TASK_RUNNER_LINUX_H_
 
+#include <glib.h>
+
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include "task_runner.h"
 
 namespace flutter_webrtc_plugin {
 
+// Runs tasks on the GLib main context. Producers on any thread push onto a
+// lock-free queue per priority lane, and only the push that finds all lanes
+// empty schedules an idle source. Each dispatch of that source runs every
+// lane up to its budget, outside of any lock, and the source stays attached
+// while tasks remain.
 class TaskRunnerLinux : public TaskRunner {
  public:
   TaskRunnerLinux() = default;
   ~TaskRunnerLinux() override = default;
 
   // TaskRunner implementation.
-  void EnqueueTask(TaskClosure task) override;
+  void EnqueueTask(TaskClosure task,
+                   TaskPriority priority = TaskPriority::kControl) override;
 
  private:
-  std::mutex tasks_mutex_;
-  std::queue<TaskClosure> tasks_;
+  // Vyukov's intrusive multi-producer single-consumer list.
+  class TaskQueue {
+   public:
+    TaskQueue();
+    ~TaskQueue();
+
+    // Any thread.
+    void Push(TaskClosure task);
+    // Main thread only. Returns false when the queue is empty, or while the
+    // next task is still being linked in by its producer.
+    bool Pop(TaskClosure* task);
+
+   private:
+    struct Node {
+      std::atomic<Node*> next{nullptr};
+      TaskClosure task;
+    };
+
+    void PushNode(Node* node);
+    Node* PopNode();
+
+    // Producers swap themselves in at |head_|; the consumer pops at |tail_|.
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+  };
+
+  static gboolean RunTasks(gpointer user_data);
+
+  TaskQueue lanes_[kTaskPriorityCount];
+
+  // Tasks pushed and not yet run, over all lanes. Producers count after
+  // pushing, so it can briefly go negative when the consumer runs a task
+  // before its producer has counted it.
+  std::atomic<int64_t> pending_{0};
 };
 
 }  // namespace flutter_webrtc_plugin
 
-#endif  // PACKAGES_FLUTTER_WEBRTC_LINUX_TASK_RUNNER_LINUX_H_
\ No newline at end of file
+#endif  // PACKAGES_FLUTTER_WEBRTC_LINUX_TASK_RUNNER_LINUX_H_
@@ -0,0 +1,60 @@
+import 'package:flutter/services.dart';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:flutter_webrtc/src/native/event_channel.dart';
+
+const eventChannelName = 'FlutterWebRTC/testEvent';
+
+Future<void> sendEvent(Object? event) {
+  return ServicesBinding.instance.defaultBinaryMessenger.handlePlatformMessage(
+      eventChannelName,
+      const StandardMethodCodec().encodeSuccessEnvelope(event),
+      (ByteData? data) {});
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final channel = MethodChannel(eventChannelName);
+  final calls = <MethodCall>[];
+  setUp(() {
+    calls.clear();
+    channel.setMockMethodCallHandler((MethodCall methodCall) async {
+      calls.add(methodCall);
+      return null;
+    });
+  });
+
+  tearDown(() {
+    channel.setMockMethodCallHandler(null);
+  });
+
+  test('Batched events are flattened and single events pass through',
+      () async {
+    final events = [];
+    final subscription =
+        receiveBatchedBroadcastStream(EventChannel(eventChannelName))
+            .listen(events.add);
+    await pumpEventQueue();
+
+    expect(calls.single.method, 'listen');
+    expect(calls.single.arguments, {'batchEvents': true});
+
+    await sendEvent([
+      {'event': 'onFirstFrameRendered', 'id': 1},
+      {'event': 'didTextureChangeVideoSize', 'id': 1, 'width': 640},
+    ]);
+    await sendEvent({'event': 'peerConnectionState', 'state': 'connected'});
+    await pumpEventQueue();
+
+    expect(events, [
+      {'event': 'onFirstFrameRendered', 'id': 1},
+      {'event': 'didTextureChangeVideoSize', 'id': 1, 'width': 640},
+      {'event': 'peerConnectionState', 'state': 'connected'},
+    ]);
+
+    await subscription.cancel();
+    await pumpEventQueue();
+    expect(calls.last.method, 'cancel');
+  });
+}
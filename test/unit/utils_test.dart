@@ -0,0 +1,72 @@
+import 'package:flutter/services.dart';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:flutter_webrtc/src/native/utils.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final channel = MethodChannel('FlutterWebRTC.Method');
+  final eventChannel = MethodChannel('FlutterWebRTC.Event');
+  final calls = <MethodCall>[];
+  setUp(() {
+    calls.clear();
+    channel.setMockMethodCallHandler((MethodCall methodCall) async {
+      calls.add(methodCall);
+      if (methodCall.method == 'executeBatch') {
+        return [
+          {'result': 1},
+          {
+            'error': 'badArgs',
+            'message': 'no such track',
+            'details': {'trackId': 'track1'},
+          },
+          {'error': 'notImplemented', 'message': 'noSuchMethod'},
+          {'result': null},
+        ];
+      }
+      return null;
+    });
+    eventChannel.setMockMethodCallHandler((MethodCall methodCall) async {
+      return null;
+    });
+  });
+
+  tearDown(() {
+    channel.setMockMethodCallHandler(null);
+    eventChannel.setMockMethodCallHandler(null);
+  });
+
+  test('executeBatch returns each reply in the slot of its call', () async {
+    final results = await WebRTC.executeBatch([
+      MethodCall('getVersion'),
+      MethodCall('trackDispose', {'trackId': 'track1'}),
+      MethodCall('noSuchMethod'),
+      MethodCall('trackSetEnabled', {'trackId': 'track0', 'enabled': true}),
+    ]);
+
+    final batch = calls.firstWhere((call) => call.method == 'executeBatch');
+    expect(batch.arguments['calls'], [
+      {'method': 'getVersion', 'args': null},
+      {
+        'method': 'trackDispose',
+        'args': {'trackId': 'track1'},
+      },
+      {'method': 'noSuchMethod', 'args': null},
+      {
+        'method': 'trackSetEnabled',
+        'args': {'trackId': 'track0', 'enabled': true},
+      },
+    ]);
+
+    expect(results, hasLength(4));
+    expect(results[0], 1);
+    final error = results[1] as PlatformException;
+    expect(error.code, 'badArgs');
+    expect(error.message, 'no such track');
+    expect(error.details, {'trackId': 'track1'});
+    expect(results[2], isA<MissingPluginException>());
+    expect((results[2] as MissingPluginException).message, 'noSuchMethod');
+    expect(results[3], isNull);
+  });
+}
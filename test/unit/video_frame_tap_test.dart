@@ -0,0 +1,92 @@
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:flutter_webrtc/src/native/video_frame_tap.dart';
+
+const tapChannel = 'FlutterWebRTC/frameTap/tap0';
+
+/// A frame message as the native tap sends it: the 24-byte little-endian
+/// header followed by the pixels, starting [offset] bytes into its buffer.
+ByteData frameMessage(int width, int height, VideoFrameTapFormat format,
+    int sequence, int timestampUs, List<int> pixels,
+    {int offset = 0}) {
+  final bytes = Uint8List(offset + 24 + pixels.length);
+  bytes.setAll(offset + 24, pixels);
+  return ByteData.sublistView(bytes, offset)
+    ..setUint32(0, width, Endian.little)
+    ..setUint32(4, height, Endian.little)
+    ..setUint8(8, format.index)
+    ..setUint32(12, sequence, Endian.little)
+    ..setInt64(16, timestampUs, Endian.little);
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  final channel = MethodChannel('FlutterWebRTC.Method');
+  final eventChannel = MethodChannel('FlutterWebRTC.Event');
+  final calls = <MethodCall>[];
+  setUp(() {
+    calls.clear();
+    channel.setMockMethodCallHandler((MethodCall methodCall) async {
+      calls.add(methodCall);
+      if (methodCall.method == 'videoTrackStartFrameTap') {
+        return {'tapId': 'tap0', 'channel': tapChannel};
+      }
+      return null;
+    });
+    eventChannel.setMockMethodCallHandler((MethodCall methodCall) async {
+      return null;
+    });
+  });
+
+  tearDown(() {
+    channel.setMockMethodCallHandler(null);
+    eventChannel.setMockMethodCallHandler(null);
+  });
+
+  test('Frames sent on the tap channel are parsed from the 24-byte header',
+      () async {
+    final tap = await VideoFrameTap.start('track0',
+        fps: 5, width: 3, height: 2, format: VideoFrameTapFormat.y);
+    final start =
+        calls.firstWhere((call) => call.method == 'videoTrackStartFrameTap');
+    expect(start.arguments['trackId'], 'track0');
+    expect(start.arguments['format'], 'y');
+
+    final next = tap.frames.first;
+    await ServicesBinding.instance.defaultBinaryMessenger
+        .handlePlatformMessage(
+            tapChannel,
+            frameMessage(3, 2, VideoFrameTapFormat.y, 0x12345678,
+                1700000000123456, [1, 2, 3, 4, 5, 6]),
+            (ByteData? data) {});
+    final frame = await next;
+
+    expect(frame.width, 3);
+    expect(frame.height, 2);
+    expect(frame.format, VideoFrameTapFormat.y);
+    expect(frame.sequence, 0x12345678);
+    expect(frame.timestampUs, 1700000000123456);
+    expect(frame.pixels, [1, 2, 3, 4, 5, 6]);
+
+    await tap.stop();
+    expect(calls.last.method, 'videoTrackStopFrameTap');
+    expect(calls.last.arguments['tapId'], 'tap0');
+  });
+
+  test('Pixels are read relative to the message, not its buffer', () {
+    final frame = TappedVideoFrame.fromMessage(frameMessage(
+        1, 1, VideoFrameTapFormat.rgb, 1, -1, [0xff, 0x80, 0x00],
+        offset: 8));
+
+    expect(frame.width, 1);
+    expect(frame.height, 1);
+    expect(frame.format, VideoFrameTapFormat.rgb);
+    expect(frame.sequence, 1);
+    expect(frame.timestampUs, -1);
+    expect(frame.pixels, [0xff, 0x80, 0x00]);
+  });
+}
@@ -38,10 +38,10 @@
    UnregisterClass(window_class_name_.c_str(), nullptr);
  }
  
- void TaskRunnerWindows::EnqueueTask(TaskClosure task) {
+ void TaskRunnerWindows::EnqueueTask(TaskClosure task, TaskPriority priority) {
    {
      std::lock_guard<std::mutex> lock(tasks_mutex_);
-     tasks_.push(task);
+     tasks_[static_cast<int>(priority)].push(std::move(task));
    }
    if (!PostMessage(window_handle_, WM_NULL, 0, 0)) {
      DWORD error_code = GetLastError();
@@ -53,13 +53,32 @@
  void TaskRunnerWindows::ProcessTasks() {
    // Even though it would usually be sufficient to process only a single task
    // whenever we receive the message, if the message queue happens to be full,
-   // we might not receive a message for each individual task.
-   for (;;) {
+   // we might not receive a message for each individual task. Each lane runs
+   // up to its budget, and tasks the budgets leave over get another message,
+   // so other window messages are handled in between.
+   for (int lane = 0; lane < kTaskPriorityCount; lane++) {
+     for (int i = 0; i < kTaskPriorityBudgets[lane]; i++) {
+       TaskClosure task;
+       {
+         std::lock_guard<std::mutex> lock(tasks_mutex_);
+         if (tasks_[lane].empty()) break;
+         task = std::move(tasks_[lane].front());
+         tasks_[lane].pop();
+       }
+       task();
+     }
+   }
+   bool tasks_left = false;
+   {
      std::lock_guard<std::mutex> lock(tasks_mutex_);
-     if (tasks_.empty()) break;
-     TaskClosure task = tasks_.front();
-     tasks_.pop();
-     task();
+     for (const auto& lane : tasks_) {
+       tasks_left |= !lane.empty();
+     }
+   }
+   if (tasks_left && !PostMessage(window_handle_, WM_NULL, 0, 0)) {
+     DWORD error_code = GetLastError();
+     std::cerr << "Failed to post message to main thread; error_code: "
+               << error_code << std::endl;
    }
  }
  
@@ -23,7 +23,8 @@
  //   https://github.com/flutter/engine/blob/d7c0bcfe7a30408b0722c9d47d8b0b1e4cdb9c81/shell/platform/windows/task_runner_window.h
  class TaskRunnerWindows : public TaskRunner {
   public:
-   virtual void EnqueueTask(TaskClosure task);
+   virtual void EnqueueTask(TaskClosure task,
+                            TaskPriority priority = TaskPriority::kControl);
  
    TaskRunnerWindows();
    ~TaskRunnerWindows();
@@ -44,7 +45,8 @@
    HWND window_handle_;
    std::wstring window_class_name_;
    std::mutex tasks_mutex_;
-   std::queue<TaskClosure> tasks_;
+   // One queue per TaskPriority.
+   std::queue<TaskClosure> tasks_[kTaskPriorityCount];
  
    // Prevent copying.
    TaskRunnerWindows(TaskRunnerWindows const&) = delete;